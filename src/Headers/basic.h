@@ -77,6 +77,7 @@ extern int snprintf (char *str, size_t count, const char *fmt, ...);
 # include "cstringTable.h"
 # include "genericTable.h"
 # include "filelocList.h"
+# include "useIndex.h"
 # include "enumNameList.h"
 # include "enumNameSList.h"
 # include "varKinds.h"
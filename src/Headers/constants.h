@@ -178,6 +178,9 @@
 /*@constant int DEFAULT_LIMIT=-1; @*/
 # define DEFAULT_LIMIT -1    /* unlimited messages */
 
+/*@constant int DEFAULT_HISTORYLIMIT=0; @*/
+# define DEFAULT_HISTORYLIMIT 0    /* keep all state history */
+
 /*@constant char PFX_UPPERCASE; @*/
 # define PFX_UPPERCASE '^'
 
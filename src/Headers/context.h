@@ -130,6 +130,7 @@ extern bool context_isSpecialFile (cstring p_fname);
 extern /*@observer@*/ cstring context_inFunctionName (void) /*@*/ ;
 extern ctype context_currentFunctionType (void) /*@*/ ;
 extern void context_exitCFile (void);
+extern void context_compactFile (fileId p_fid) ;
 extern void context_enterConstantMacro (/*@dependent@*/ /*@exposed@*/ uentry p_e);
 extern void context_enterMacro (/*@observer@*/ uentry p_e);
 extern void context_enterFunction (/*@exposed@*/ uentry p_e);
@@ -140,6 +141,7 @@ extern void context_exitInner (exprNode p_exp);
 extern bool context_globAccess (sRef p_s);
 extern /*@observer@*/ globSet context_getUsedGlobs (void);
 extern bool context_hasAccess (typeId p_t);
+extern typeIdSet context_currentAccess (void) /*@*/ ;
 extern bool context_couldHaveAccess (typeId p_t);
 extern /*@only@*/ cstring context_unparse (void) /*@*/ ; 
 extern void context_setFunctionDefined (fileloc p_loc);
@@ -298,6 +300,9 @@ extern bool context_anyErrors (void) /*@globals internalState@*/ ;
 extern void context_hasError (void) /*@modifies internalState@*/ ;
 extern int context_numErrors (void) /*@globals internalState@*/ ;
 
+extern void context_setBatchJob (int p_job) /*@modifies internalState@*/ ;
+extern int context_getBatchJob (void) /*@globals internalState@*/ ;
+
 extern void context_recordBug (void) /*@modifies internalState@*/ ;
 extern int context_numBugs (void) /*@globals internalState@*/ ;
 
@@ -331,6 +336,11 @@ extern /*@observer@*/ metaStateTable context_getMetaStateTable (void)
 extern /*@observer@*/ metaStateInfo context_lookupMetaStateInfo (cstring p_key) 
      /*@globals internalState@*/ ;
 
+extern /*@observer@*/ metaStateInfo context_getMetaStateInfo (int p_id) 
+     /*@globals internalState@*/ ;
+
+extern int context_numMetaStates (void) /*@globals internalState@*/ ;
+
 extern void context_addAnnotation (/*@only@*/ annotationInfo)
      /*@modifies internalState@*/ ;
 
@@ -121,6 +121,11 @@ struct file_name_map_list;
 /*@constant int CPP_STACK_MAX; @*/
 # define CPP_STACK_MAX 200
 
+/* Number of hash chains over all_include_files.  */
+
+/*@constant int CPP_INCLUDEHASHSIZE; @*/
+# define CPP_INCLUDEHASHSIZE 1403
+
 /* A cppReader encapsulates the "state" of a pre-processor run.
    Applying cppGetToken repeatedly yields a stream of pre-processor
    tokens.  Usually, there is only one cppReader object active. */
@@ -153,6 +158,19 @@ struct cppReader {
      around the entire contents, and ->control_macro gives the macro name.  */
   /*@owned@*/ /*@null@*/ struct file_name_list *all_include_files;
 
+  /* Hash chains over all_include_files, linked through ->hash_next.  */
+  /*@dependent@*/ /*@null@*/ struct file_name_list *all_include_hash[CPP_INCLUDEHASHSIZE];
+
+  /* Candidate include file names that could not be opened.  Lookups
+     for the same header from the same search directories do not need
+     to try them again.  */
+  /*@only@*/ /*@null@*/ cstringTable missing_includes;
+
+  /* Contents of regular files read by finclude, by file name, and
+     their total size.  */
+  /*@only@*/ /*@null@*/ genericTable file_contents;
+  size_t file_contents_size;
+
   /* Current maximum length of directory names in the search path
      for include files.  (Altered as we get more of them.)  */
   size_t max_include_len;
@@ -573,6 +591,9 @@ struct file_name_list
 
   /* Non-zero if name_map is valid.  */
   bool got_name_map;
+
+  /* Next entry in the same all_include_hash chain.  */
+  /*@dependent@*/ /*@null@*/ struct file_name_list *hash_next;
 };
 
 extern void cppReader_addIncludeChain (/*@special@*/ cppReader *p_pfile, 
@@ -49,15 +49,15 @@ extern void cscannerHelp_advanceLine (void) /*@modifies g_currentloc, internalSt
 extern /*@observer@*/ cstring cscannerHelp_observeLastIdentifier (void) ;
 extern int cscannerHelp_handleLlSpecial (void) /*@modifies g_currentloc, internalState@*/ ; 
 extern bool cscannerHelp_handleSpecial (char *) /*@modifies g_currentloc, internalState@*/ ;
-extern /*@only@*/ cstring cscannerHelp_makeIdentifier (char *);
+extern /*@observer@*/ cstring cscannerHelp_makeIdentifier (char *) /*@modifies internalState@*/ ;
 
 extern bool cscannerHelp_isConstraintToken (int p_tok) /*@*/ ;
 
 extern int cscannerHelp_handleNewLine (void) /*@modifies g_currentloc, internalState@*/ ;
 
 extern int cscannerHelp_processTextIdentifier (char *) /*@modifies internalState@*/ ;
-extern int cscannerHelp_processIdentifier (/*@only@*/ cstring) /*@modifies internalState@*/ ;
-extern bool cscannerHelp_processHashIdentifier (/*@only@*/ cstring) /*@modifies internalState@*/ ;
+extern int cscannerHelp_processIdentifier (/*@observer@*/ cstring) /*@modifies internalState@*/ ;
+extern bool cscannerHelp_processHashIdentifier (/*@observer@*/ cstring) /*@modifies internalState@*/ ;
 
 extern int cscannerHelp_processSpec (int p_tok) /*@modifies internalState@*/ ;
 extern char cscannerHelp_processChar (void) /*@modifies internalState@*/ ;
@@ -110,6 +110,7 @@ extern bool fileId_isHeader (fileId p_f) /*@*/ ;
 # define fileId_isHeader(f)          (fileTable_isHeader (context_fileTable(), f))
 
 extern bool fileTable_sameBase (fileTable p_ft, fileId p_f1, fileId p_f2);
+extern fileId fileTable_baseId (fileTable p_ft, fileId p_fid) /*@*/ ;
 extern void fileTable_cleanup (fileTable p_ft) /*@modifies fileSystem@*/;
 extern fileId fileTable_lookupBase (fileTable p_ft, cstring p_base) /*@modifies p_ft@*/ ;
 extern void fileTable_printTemps (fileTable p_ft) /*@modifies g_warningstream@*/ ;
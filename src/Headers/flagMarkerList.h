@@ -12,11 +12,32 @@
 
 typedef /*@only@*/ flagMarker o_flagMarker;
 
+/*
+** The elements of one file: byloc holds their indexes sorted by
+** location, and maxindex[i] the largest of byloc[0..i].
+*/
+
+typedef struct
+{
+  int n;
+  int space;
+  /*@null@*/ /*@only@*/ int *byloc;
+  /*@null@*/ /*@only@*/ int *maxindex;
+} flagMarkerFileIndex;
+
 abst_typedef struct
 {
   int nelements;
   int nspace;
   /*@reldef@*/ /*@relnull@*/ o_flagMarker  *elements;
+
+  /* Indexes of the elements in each file, by base fileId. */
+  int nfiles;
+  /*@null@*/ /*@only@*/ flagMarkerFileIndex *files;
+
+  /* Open hash table of the elements by line and column. */
+  int hashsize;
+  /*@null@*/ /*@only@*/ /*@reldef@*/ flagMarker *hashed;
 } *flagMarkerList ;
 
 extern /*@only@*/ flagMarkerList flagMarkerList_new (void) /*@*/ ;
@@ -40,6 +61,9 @@ extern bool
 /*@constant int flagMarkerListBASESIZE;@*/
 # define flagMarkerListBASESIZE SMALLBASESIZE
 
+/*@constant int flagMarkerListHASHBASESIZE;@*/
+# define flagMarkerListHASHBASESIZE 256
+
 # else
 # error "Multiple include"
 # endif
@@ -27,10 +27,10 @@ typedef enum
 # define NUMFLAGS       (LAST_FLAG)
 
 /*@constant int NUMVALUEFLAGS; @*/
-# define NUMVALUEFLAGS       15
+# define NUMVALUEFLAGS       16
 
 /*@constant int NUMSTRINGFLAGS; @*/
-# define NUMSTRINGFLAGS      28
+# define NUMSTRINGFLAGS      30
 
 /*@iter allFlagCodes (yield flagcode f); @*/
 # define allFlagCodes(m_code) \
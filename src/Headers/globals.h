@@ -24,6 +24,9 @@ extern /*@owned@*/ fileloc g_currentloc;
 /* stream for error messages */
 /*@unchecked@*/ extern /*@null@*/ /*@dependent@*/ /*:open:*/ FILE *g_csvstream; 
 
+/* stream for JSON Lines warnings output */
+/*@unchecked@*/ extern /*@null@*/ /*@dependent@*/ /*:open:*/ FILE *g_jsonstream; 
+
 /*@-ansireserved@*/
 /* This macro is defined by flex. */
 /*@constant external int ECHO@*/
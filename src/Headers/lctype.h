@@ -293,6 +293,14 @@ extern bool ctype_isWideString (ctype p_c) /*@*/ ;
 
 extern ctype ctype_newBase (ctype p_c, ctype p_p) /*@*/ ;
 extern ctype ctype_realType (ctype p_c) /*@*/ ;
+
+/*
+** The real types (and predicates on them) are memoized until a type
+** definition changes; the code that changes one calls this.
+*/
+
+extern void ctype_invalidateRealTypes (void) /*@modifies internalState@*/ ;
+
 extern ctype ctype_realishType (ctype p_c) /*@*/ ;
 extern ctype ctype_removePointers (ctype p_c) /*@*/ ;
 extern ctype ctype_resolve (ctype p_c) /*@*/ ;
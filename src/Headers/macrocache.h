@@ -43,6 +43,7 @@ extern void
   macrocache_addComment (macrocache p_s, /*@only@*/ fileloc p_fl, /*@only@*/ cstring p_def);
 
 extern void macrocache_free (/*@only@*/ macrocache p_s);
+extern int macrocache_compact (macrocache p_s, fileId p_fid) /*@modifies p_s@*/ ;
 extern void macrocache_finalize (void) /*@modifies internalState@*/ ;
 
 # else
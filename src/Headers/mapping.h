@@ -19,6 +19,7 @@ typedef /*@relnull@*/ /*@only@*/ mappair *o_mappair;
 
 typedef /*@abstract@*/ struct {
   unsigned int count;
+  unsigned int size; /* number of buckets, a power of two */
   /*@relnull@*/ /*@only@*/ o_mappair *buckets;  
 } *mapping;
 
@@ -35,6 +35,8 @@ extern /*@unused@*/ /*@falsewhennull@*/ bool
 extern /*@only@*/ messageLog messageLog_new (void) /*@*/ ;
 extern bool messageLog_add (messageLog p_s, fileloc p_fl, cstring p_mess) 
             /*@modifies p_s@*/ ;
+extern int messageLog_removeFile (messageLog p_s, fileId p_fid) 
+            /*@modifies p_s@*/ ;
 
 extern /*@only@*/ /*@unused@*/ cstring messageLog_unparse (messageLog p_s)  /*@*/ ;
 extern void messageLog_free (/*@only@*/ messageLog p_s) ;
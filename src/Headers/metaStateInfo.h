@@ -23,6 +23,7 @@
 
 struct s_metaStateInfo {
   /*@only@*/ cstring name;
+  int id; /* index of the state in value tables (see context_addMetaState) */
   fileloc loc;
   /* metaStateKind type; */
   cstringList valueNames;
@@ -58,6 +59,11 @@ metaStateInfo_create (/*@only@*/ cstring p_name,
 extern bool metaStateInfo_equal (metaStateInfo p_m1, metaStateInfo p_m2) /*@*/ ;
 # define metaStateInfo_equal(m1,m2) ((m1) == (m2))
 
+extern int metaStateInfo_getId (metaStateInfo p_info) /*@*/ ;
+# define metaStateInfo_getId(p_info) ((p_info)->id)
+
+extern void metaStateInfo_setId (metaStateInfo p_info, int p_id) /*@modifies p_info@*/ ;
+
 extern int metaStateInfo_getDefaultValueContext (metaStateInfo p_info, mtContextKind p_context) /*@*/ ;
 extern void metaStateInfo_setDefaultValueContext (metaStateInfo p_info, mtContextKind p_context, int p_val) /*@modifies p_info@*/ ;
 
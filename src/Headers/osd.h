@@ -94,6 +94,9 @@ extern int osd_unlink (cstring) /*@modifies fileSystem@*/ ;
 extern cstring osd_fixDefine (cstring);
 extern bool osd_fileIsReadable (cstring);
 
+extern bool osd_runInChild (/*@out@*/ int *p_status) 
+   /*@modifies fileSystem, *p_status@*/ ;
+
 extern bool osd_isConnectChar (char) /*@*/ ;
 extern /*@observer@*/ cstring osd_getCurrentDirectory (void) /*@*/ ;
 
@@ -14,5 +14,8 @@ extern bool rcfiles_read (cstring p_fname,
 			  cstringList *p_passThroughArgs,
 			  bool p_report) 
   /*@modifies fileSystem, internalState, *p_passThroughArgs@*/ ;
+
+extern bool rcfiles_readJob (FILE *p_f, /*@out@*/ cstringList *p_args)
+  /*@modifies fileSystem, p_f, *p_args@*/ ;
    
 # endif
@@ -126,6 +126,13 @@ struct s_sRef
   /*@null@*/ /*@only@*/ stateInfo nullinfo;  
 
   /*@only@*/ /*@relnull@*/ sinfo info;
+
+  /*
+  ** Structural hash of kind and info (0 if not hashable), valid
+  ** while shapeepoch matches the current epoch in sRef.c.
+  */
+  unsigned int shape;
+  int shapeepoch;
   
   /* stores fields for structs, elements for arrays, derefs for pointers */
   /*@only@*/ sRefSet deriv; 
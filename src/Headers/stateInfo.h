@@ -62,12 +62,21 @@ typedef enum {
 
 } stateAction;
 
+/*
+** State histories are immutable once created: a copy shares the whole
+** list, and updates add a new entry in front of a shared tail.  Entries
+** are reference counted (by the stateInfo values and entries that refer
+** to them), and depth is the length of the list from this entry.
+*/
+
 /*@null@*/ struct s_stateInfo
 {
   /*@only@*/ fileloc loc;
   stateAction action;
   /*@observer@*/ sRef ref;
   /*@null@*/ stateInfo previous;
+  int refs;
+  int depth;
 } ;
 
 /*@constant null stateInfo stateInfo_undefined@*/
@@ -107,8 +116,8 @@ extern stateAction stateAction_fromNState (nstate p_ns) /*@*/ ;
 extern stateAction stateAction_fromExkind (exkind p_ex) /*@*/ ;
 extern stateAction stateAction_fromAlkind (alkind p_ak) /*@*/ ;
 
-extern void stateInfo_display (stateInfo p_s, /*@only@*/ cstring p_sname) 
-  /*@modifies g_errorstream@*/ ;
+extern void stateInfo_display (stateInfo *p_sp, /*@only@*/ cstring p_sname) 
+  /*@modifies *p_sp, g_errorstream@*/ ;
 
 # else
 # error "Multiple include"
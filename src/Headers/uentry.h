@@ -151,8 +151,12 @@ struct s_uentry
 
   warnClause warn;
 
-  /* Location list is complete only if showalluses is set. */
+  /* 
+  ** Location list of uses for exportlocal.  With showalluses, the 
+  ** uses are recorded in the useIndex under useid instead.
+  */
   filelocList uses; 
+  useId useid;
 
   bool                  used BOOLBITS;       
   bool                  lset BOOLBITS;      /* set in local table */
@@ -594,6 +598,9 @@ extern void uentry_setParamNo (uentry p_ue, int p_pno) /*@modifies p_ue@*/;
 extern /*@observer@*/ filelocList uentry_getUses (/*@sef@*/ uentry p_e) /*@*/ ;
 # define uentry_getUses(u) (uentry_isValid (u) ? (u)->uses : filelocList_undefined)
 
+extern useId uentry_getUseId (/*@sef@*/ uentry p_e) /*@*/ ;
+# define uentry_getUseId(u) (uentry_isValid (u) ? (u)->useid : useId_invalid)
+
 extern bool uentry_isCheckedUnknown (uentry p_ue) /*@*/ ;
 extern bool uentry_isCheckedModify (uentry p_ue) /*@*/ ;
 extern bool uentry_isUnchecked (uentry p_ue) /*@*/ ;
@@ -0,0 +1,47 @@
+/*
+** Copyright (C) University of Virginia, Massachusetts Institue of Technology 1994-2003.
+** See ../LICENSE for license information.
+**
+*/
+/*
+** useIndex.h
+**
+** With +showalluses, the uses of globals are appended to a temporary
+** file instead of being kept in memory.  Each uentry with uses holds a
+** useId; merging the uses of two entries merges their ids.
+*/
+
+# ifndef useIndex_H
+# define useIndex_H
+
+immut_typedef int useId;
+
+/*@constant useId useId_invalid; @*/
+# define useId_invalid -1
+
+extern bool useId_isValid (useId) /*@*/ ;
+# define useId_isValid(u) ((u) > useId_invalid)
+
+extern useId useIndex_add (useId p_id, fileloc p_loc)
+   /*@modifies internalState, fileSystem@*/ ;
+
+extern useId useIndex_merge (useId p_id, useId p_other)
+   /*@modifies internalState@*/ ;
+
+extern int useIndex_count (useId p_id) /*@modifies internalState@*/ ;
+
+extern /*@only@*/ filelocList *useIndex_read (useId *p_ids, int p_n)
+   /*@modifies internalState, fileSystem@*/ ;
+
+extern void useIndex_destroyMod (void) /*@modifies internalState@*/ ;
+
+/*
+** Maximum number of uses read back into memory at once.
+*/
+
+/*@constant int USEINDEX_READLIMIT; @*/
+# define USEINDEX_READLIMIT 1000000
+
+# else
+# error "Multiple include"
+# endif
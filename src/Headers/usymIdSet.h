@@ -28,6 +28,7 @@ extern usymIdSet usymIdSet_undump (char **p_s);
 extern /*@only@*/ usymIdSet usymIdSet_single (usymId p_t);
 
 extern int usymIdSet_compare (usymIdSet p_l1, usymIdSet p_l2);
+extern unsigned int usymIdSet_hash (usymIdSet p_s) /*@*/ ;
 
 /*@constant int usymIdSetBASESIZE;@*/
 # define usymIdSetBASESIZE SMALLBASESIZE
@@ -19,9 +19,23 @@ typedef enum {
   US_CBRANCH, US_SWITCH
 } uskind;
 
-typedef struct { int level; int index; } *refentry;
-typedef /*@only@*/ refentry o_refentry;
-typedef o_refentry *refTable;
+typedef struct { int level; int index; } refentry;
+
+/*
+** A branch environment's refTable records, for each entry, the level
+** and index of the entry it copies.  The hash maps (level, index) to
+** the entry, so references are found without scanning the branch.
+*/
+
+typedef struct
+{
+  /*@reldef@*/ /*@only@*/ refentry *elements;
+  int hashsize;
+  /*@only@*/ int *hashed;
+} *refTable;
+
+/*@constant int REFTABLEHASHBASESIZE;@*/
+# define REFTABLEHASHBASESIZE 8
 
 struct s_usymtab
 {
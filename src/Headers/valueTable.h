@@ -7,60 +7,92 @@
 */
 
 /*
-** valueTable is a table of stateValue's.
-** Based on genericTable
+** valueTable is a table of stateValue's, indexed by the id of the
+** metastate (see context_addMetaState).  Entries for metastates that
+** do not apply are NULL.
 */
 
 # ifndef VTABLE_H
 # define VTABLE_H
 
+struct s_valueTable
+{
+  int size;
+  /*@reldef@*/ /*@only@*/ /*@null@*/ stateValue *values;
+} ;
+
 /*@constant null valueTable valueTable_undefined; @*/
-# define valueTable_undefined genericTable_undefined
+# define valueTable_undefined ((valueTable) NULL)
 
 extern /*@falsewhennull@*/ bool valueTable_isDefined(valueTable) /*@*/ ;
-# define valueTable_isDefined(p_h) (genericTable_isDefined ((genericTable) (p_h)))
+# define valueTable_isDefined(p_h) ((p_h) != valueTable_undefined)
 
 extern /*@nullwhentrue@*/ bool valueTable_isUndefined(valueTable) /*@*/ ;
-# define valueTable_isUndefined(p_h) (genericTable_isUndefined ((genericTable) (p_h)))
+# define valueTable_isUndefined(p_h) ((p_h) == valueTable_undefined)
+
+extern /*@only@*/ /*@notnull@*/ valueTable valueTable_create (int p_size) /*@*/ ;
+
+extern void valueTable_insertId (/*@notnull@*/ valueTable p_h, int p_id,
+				 /*@only@*/ stateValue p_value)
+     /*@modifies p_h@*/ ;
+
+extern void valueTable_updateId (/*@notnull@*/ valueTable p_h, int p_id,
+				 /*@owned@*/ stateValue p_newval)
+     /*@modifies p_h@*/ ;
+
+extern /*@null@*/ /*@dependent@*/ /*@exposed@*/ stateValue 
+   valueTable_lookupId (/*@sef@*/ valueTable p_h, /*@sef@*/ int p_id) /*@*/ ;
+# define valueTable_lookupId(p_h,p_id) \
+  ((valueTable_isDefined (p_h) && (p_id) < (p_h)->size) \
+   ? (p_h)->values[p_id] : stateValue_undefined)
 
-extern /*@only@*/ valueTable valueTable_create(int p_size);
-# define valueTable_create(p_s) ((valueTable) genericTable_create (p_s))
+/*
+** Lookups by metastate name.
+*/
 
-extern void valueTable_insert (valueTable p_h, 
+extern void valueTable_insert (/*@notnull@*/ valueTable p_h, 
 			       /*@only@*/ cstring p_key, 
-			       /*@only@*/ stateValue p_value);
+			       /*@only@*/ stateValue p_value)
+     /*@modifies p_h@*/ ;
 
-/*@access stateValue@*/
 extern /*@null@*/ /*@dependent@*/ /*@exposed@*/ stateValue 
    valueTable_lookup (valueTable p_h, cstring p_key) /*@*/ ;
-# define valueTable_lookup(p_h,p_key) \
-  ((stateValue) genericTable_lookup ((genericTable) (p_h), p_key))
-/*@noaccess stateValue@*/
 
 extern bool valueTable_contains (valueTable p_h, cstring p_key) /*@*/ ;
 # define valueTable_contains(p_h,p_key) \
  (stateValue_isDefined (valueTable_lookup (p_h, p_key)))
 
-extern /*@unused@*/ /*@only@*/ cstring valueTable_stats(valueTable p_h);
-# define valueTable_stats(p_h) genericTable_stats ((genericTable) (p_h))
+extern void valueTable_update (/*@notnull@*/ valueTable p_h, cstring p_key,
+			       /*@owned@*/ stateValue p_newval) /*@modifies p_h@*/ ;
 
 extern void valueTable_free (/*@only@*/ valueTable p_h);
-# define valueTable_free(p_h) (genericTable_free ((genericTable) (p_h)))
 
 extern /*@only@*/ cstring valueTable_unparse (valueTable p_h) /*@*/ ;
 
-extern void valueTable_update (valueTable p_h, cstring p_key, /*@owned@*/ stateValue p_newval) /*@modifies p_h@*/ ;
-
 extern /*@only@*/ valueTable valueTable_copy (valueTable p_s) ;
 
-/*@iter valueTable_elements (sef valueTable p_g, yield exposed cstring m_key, yield exposed stateValue m_el)@*/
+/*@iter valueTable_elementsId (sef valueTable p_g, yield int m_id, yield exposed stateValue m_el)@*/
 
-# define valueTable_elements(p_g, m_key, m_el) genericTable_elements (p_g, m_key, m_el)
-# define end_valueTable_elements end_genericTable_elements
+# define valueTable_elementsId(p_g, m_id, m_el) \
+  { if (valueTable_isDefined (p_g)) \
+      { int m_id; \
+        for (m_id = 0; m_id < (p_g)->size; m_id++) \
+          { stateValue m_el = (p_g)->values[m_id]; \
+            if (stateValue_isDefined (m_el)) \
+              {
+# define end_valueTable_elementsId }}}}
+
+/*
+** As valueTable_elementsId, also yielding the name of each metastate.
+*/
 
-extern int valueTable_size (valueTable p_h) /*@*/ ;
-# define valueTable_size(p_h) (genericTable_size(p_h))
+/*@iter valueTable_elements (sef valueTable p_g, yield int m_id, yield exposed cstring m_key, yield exposed stateValue m_el)@*/
 
+# define valueTable_elements(p_g, m_id, m_key, m_el) \
+  valueTable_elementsId (p_g, m_id, m_el) \
+    { /*@observer@*/ cstring m_key = \
+        metaStateInfo_getName (context_getMetaStateInfo (m_id));
+# define end_valueTable_elements } end_valueTable_elementsId
 
 # else
 # error "Multiple include"
@@ -103,6 +103,7 @@ static struct
 
   int numerrors;
   int numbugs;
+  int batchjob; /* number of the -batch job being run, or 0 */
 
   filelocStack locstack;
   fileTable ftab;
@@ -146,6 +147,11 @@ static struct
   sRefSetList modrecs; /* Keep track of file static symbols modified. */
 
   metaStateTable stateTable; /* User-defined state information. */
+
+  /* The user-defined states, indexed by id. */
+  int nmetaStates;
+  int metaStatesSpace;
+  /*@null@*/ /*@only@*/ /*@reldef@*/ metaStateInfo *metaStates; /* elements owned by stateTable */
   annotationTable annotTable; /* User-defined annotations table. */
   union u_cont
     {
@@ -720,6 +726,8 @@ context_resetAllFlags (void)
 	    {
 	    case FLG_LIMIT: 
 	      val = DEFAULT_LIMIT; break;
+	    case FLG_HISTORYLIMIT: 
+	      val = DEFAULT_HISTORYLIMIT; break;
 	    case FLG_BUGSLIMIT:
 	      val = DEFAULT_BUGSLIMIT; break;
 	    case FLG_LINELEN: 
@@ -2177,6 +2185,16 @@ context_hasFileAccess (typeId t)
   return (typeIdSet_member (gc.facct, t));
 }
 
+/*
+** The access set context_hasAccess checks.
+*/
+
+typeIdSet
+context_currentAccess (void)
+{
+  return (context_inFunctionLike () ? gc.acct : gc.facct);
+}
+
 /*@only@*/ cstring
 context_unparseAccess (void)
 {
@@ -2828,6 +2846,7 @@ context_setValue (flagcode flag, int val)
     case FLG_NUMSTRUCTFIELDS:
     case FLG_NUMENUMMEMBERS:      
     case FLG_INDENTSPACES:
+    case FLG_HISTORYLIMIT:
       if (val < 0)
 	{
 	  llerror_flagWarning (message ("Value for %s must be a non-negative "
@@ -3014,6 +3033,12 @@ context_setString (flagcode flag, cstring val)
 	  }
 	break;
       }
+    case FLG_BOOLTYPE:
+      {
+	/* the memoized real types depend on which type is bool */
+	ctype_invalidateRealTypes ();
+	break;
+      }
     default:
       {
 	; /* Okay not handle everything in this switch */
@@ -3078,6 +3103,7 @@ void context_initMod (void)
   gc.instandardlib = FALSE;
   gc.numerrors = 0;
   gc.numbugs = 0;
+  gc.batchjob = 0;
   gc.neednl = FALSE;
   gc.linesprocessed = 0;
   gc.speclinesprocessed = 0;
@@ -3147,6 +3173,9 @@ void context_initMod (void)
   context_setMode (DEFAULT_MODE);
 
   gc.stateTable = metaStateTable_create ();
+  gc.nmetaStates = 0;
+  gc.metaStatesSpace = 0;
+  gc.metaStates = NULL;
   gc.annotTable = annotationTable_create ();
 
   gc.inFunctionHeader = FALSE;
@@ -3646,6 +3675,24 @@ context_exitCFile (void)
   */
 }
 
+/*
+** Discards state kept for file fid (set by +compactfiles) once it has
+** been checked.  Messages and macros are located in the original
+** source file, not the preprocessed file that was checked, so fid must
+** be a base id.
+*/
+
+void
+context_compactFile (fileId fid)
+{
+  int nmessages = messageLog_removeFile (gc.msgLog, fid);
+  int nmacros = macrocache_compact (gc.mc, fid);
+
+  displayScan (message ("compacted %q: %d logged messages, %d macro definitions",
+			osd_outputPath (fileTable_rootFileName (fid)),
+			nmessages, nmacros));
+}
+
 void
 context_exitMacroCache (void)
 {
@@ -4395,6 +4442,7 @@ context_destroyMod (void)
   cstring_free (gc.msgAnnote);
   globSet_free (gc.globs_used);
   metaStateTable_free (gc.stateTable);
+  sfree (gc.metaStates);
   annotationTable_free (gc.annotTable);
 }
 
@@ -4485,6 +4533,16 @@ int context_numErrors (void)
   return gc.numerrors;
 }
 
+void context_setBatchJob (int job)
+{
+  gc.batchjob = job;
+}
+
+int context_getBatchJob (void)
+{
+  return gc.batchjob;
+}
+
 bool context_neednl (void)
 {
   return gc.neednl;
@@ -4815,6 +4873,18 @@ metaStateInfo context_lookupMetaStateInfo (cstring key)
   return metaStateTable_lookup (gc.stateTable, key);
 }
 
+metaStateInfo context_getMetaStateInfo (int id)
+{
+  llassert (gc.metaStates != NULL);
+  llassert (id >= 0 && id < gc.nmetaStates);
+  return gc.metaStates[id];
+}
+
+int context_numMetaStates (void)
+{
+  return gc.nmetaStates;
+}
+
 /*@null@*/ annotationInfo context_lookupAnnotation (cstring annot) 
 {
   return annotationTable_lookup (gc.annotTable, annot);
@@ -4851,30 +4921,52 @@ void context_addMetaState (cstring mname, metaStateInfo msinfo)
   else
     {
       DPRINTF (("Adding meta state: %s", mname));
+
+      if (gc.nmetaStates >= gc.metaStatesSpace)
+	{
+	  int newspace = (gc.metaStatesSpace == 0) ? SMALLBASESIZE : 2 * gc.metaStatesSpace;
+	  metaStateInfo *newstates = (metaStateInfo *) 
+	    dmalloc (sizeof (*newstates) * newspace);
+	  int i;
+
+	  for (i = 0; i < gc.nmetaStates; i++)
+	    {
+	      llassert (gc.metaStates != NULL);
+	      newstates[i] = gc.metaStates[i];
+	    }
+
+	  sfree (gc.metaStates);
+	  gc.metaStates = newstates;
+	  gc.metaStatesSpace = newspace;
+	}
+
+      llassert (gc.metaStates != NULL);
+      metaStateInfo_setId (msinfo, gc.nmetaStates);
+      gc.metaStates[gc.nmetaStates] = msinfo;
+      gc.nmetaStates++;
       metaStateTable_insert (gc.stateTable, mname, msinfo); 
     }
 }
 
 valueTable context_createValueTable (sRef s, stateInfo info)
 {
-  if (metaStateTable_size (gc.stateTable) > 0)
+  if (gc.nmetaStates > 0)
     {
-      valueTable res = valueTable_create (metaStateTable_size (gc.stateTable));
-      /* should use smaller value... */
+      valueTable res = valueTable_create (gc.nmetaStates);
+      int id;
+
       DPRINTF (("Value table for: %s", sRef_unparse (s)));
       
-      metaStateTable_elements (gc.stateTable, msname, msi)
+      for (id = 0; id < gc.nmetaStates; id++)
 	{
+	  metaStateInfo msi = context_getMetaStateInfo (id);
 	  mtContextNode context = metaStateInfo_getContext (msi);
 
 	  if (mtContextNode_matchesRefStrict (context, s))
 	    {
 	      DPRINTF (("Create: %s", metaStateInfo_unparse (msi)));
-	      llassert (cstring_equal (msname, metaStateInfo_getName (msi)));
-	      
-	      valueTable_insert 
-		(res,
-		 cstring_copy (metaStateInfo_getName (msi)),
+	      valueTable_insertId 
+		(res, id,
 		 stateValue_createImplicit (metaStateInfo_getDefaultValue (msi, s), 
 					    stateInfo_copy (info)));
 	    }
@@ -4883,7 +4975,6 @@ valueTable context_createValueTable (sRef s, stateInfo info)
 	      DPRINTF (("No match: %s", metaStateInfo_unparse (msi)));
 	    }
 	} 
-      end_metaStateTable_elements ;
       
       stateInfo_free (info);
       DPRINTF (("Value table: %s", valueTable_unparse (res)));
@@ -4898,23 +4989,21 @@ valueTable context_createValueTable (sRef s, stateInfo info)
 
 valueTable context_createGlobalMarkerValueTable (stateInfo info)
 {
-  if (metaStateTable_size (gc.stateTable) > 0)
+  if (gc.nmetaStates > 0)
     {
-      valueTable res = valueTable_create (metaStateTable_size (gc.stateTable));
-      /* should use smaller value... */
+      valueTable res = valueTable_create (gc.nmetaStates);
+      int id;
       
-      metaStateTable_elements (gc.stateTable, msname, msi)
+      for (id = 0; id < gc.nmetaStates; id++)
 	{
+	  metaStateInfo msi = context_getMetaStateInfo (id);
+
 	  /* only add global...*/
 	  DPRINTF (("Create: %s", metaStateInfo_unparse (msi)));
-	  llassert (cstring_equal (msname, metaStateInfo_getName (msi)));
-	  
-	  valueTable_insert (res,
-			     cstring_copy (metaStateInfo_getName (msi)),
-			     stateValue_create (metaStateInfo_getDefaultGlobalValue (msi),
-						stateInfo_copy (info)));
+	  valueTable_insertId (res, id,
+			       stateValue_create (metaStateInfo_getDefaultGlobalValue (msi),
+						  stateInfo_copy (info)));
 	} 
-      end_metaStateTable_elements ;
       
       stateInfo_free (info);
       DPRINTF (("Value table: %s", valueTable_unparse (res)));
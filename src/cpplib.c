@@ -134,6 +134,26 @@ Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 /*@constant unused int IMPORT_NOT_FOUND@*/
 # define IMPORT_NOT_FOUND -1
 
+/*
+** Limit on the total size of file contents kept by save_file_contents.
+*/
+
+/*@constant size_t CPP_CONTENTS_MAX@*/
+# define CPP_CONTENTS_MAX ((size_t) 64 * 1024 * 1024)
+
+/*
+** Contents of a regular file read by finclude, with the size and
+** modification time it had when it was read.
+*/
+
+struct file_contents
+{
+  size_t size;
+  time_t mtime;
+  int length;
+  char contents[1];
+};
+
 #ifndef STDC_VALUE
 /*@constant unused int STDC_VALUE@*/
 #define STDC_VALUE 1
@@ -374,7 +394,16 @@ typedef unsigned int mode_t;
 # endif
 
 static int file_size_and_mode (int p_fd, /*@out@*/ mode_t *p_mode_pointer,
-			       /*@out@*/ size_t *p_size_pointer);
+			       /*@out@*/ size_t *p_size_pointer,
+			       /*@out@*/ time_t *p_mtime_pointer);
+static int lookup_file_contents (cppReader *p_pfile, cstring p_fname,
+				 size_t p_size, time_t p_mtime,
+				 /*@out@*/ char *p_buf)
+   /*@modifies p_buf@*/ ;
+static void save_file_contents (cppReader *p_pfile, cstring p_fname,
+				size_t p_size, time_t p_mtime,
+				char *p_buf, int p_length)
+   /*@modifies p_pfile@*/ ;
 static int safe_read (int p_desc, /*@out@*/ char *p_ptr, int p_len);
 
 
@@ -396,7 +425,8 @@ static void initialize_char_syntax (struct cppOptions *p_opts) ;
 static int /*@alt void@*/ finclude (cppReader *p_pfile, int p_f,
 				    cstring p_fname,
 				    bool p_system_header_p,
-				    /*@dependent@*/ /*@null@*/ struct file_name_list *p_dirptr);
+				    /*@dependent@*/ /*@null@*/ struct file_name_list *p_dirptr,
+				    bool p_included);
 
 static void validate_else (cppReader *p_pfile, cstring p_directive);
   
@@ -418,6 +448,9 @@ extern void fancy_abort ();
 #endif
 
 static bool redundant_include_p (cppReader *p_pfile, /*@null@*/ cstring p_name);
+static /*@null@*/ /*@exposed@*/ struct file_name_list *
+lookup_include_file (cppReader *p_pfile, /*@null@*/ cstring p_name) /*@*/ ;
+static bool is_missing_include (cppReader *p_pfile, cstring p_name) /*@*/ ;
 static bool is_system_include (cppReader *p_pfile, cstring p_filename);
 
 static /*@observer@*/ /*@null@*/ struct file_name_map *
@@ -4903,6 +4936,14 @@ do_include (cppReader *pfile, struct directive *keyword,
 	    }
 	  }
 #endif /* VMS */
+	  if (is_missing_include (pfile, fname))
+	    {
+	      /* Already tried this name in this directory, and it isn't there.  */
+	      cstring_free (fname);
+	      fname = cstring_undefined;
+	      continue;
+	    }
+
 	  /* ??? There are currently 3 separate mechanisms for avoiding processing
 	     of redundant include files: #import, #pragma once, and
 	     redundant_include_p.  It would be nice if they were unified.  */
@@ -4928,6 +4969,19 @@ do_include (cppReader *pfile, struct directive *keyword,
 				 message ("Header file %s exists, but is not readable", fname));
 	    }
 #endif
+	  else if (f == IMPORT_NOT_FOUND && errno == ENOENT)
+	    {
+	      if (cstringTable_isUndefined (pfile->missing_includes))
+		{
+		  pfile->missing_includes = cstringTable_create (CPP_INCLUDEHASHSIZE);
+		}
+
+	      cstringTable_insert (pfile->missing_includes, cstring_copy (fname), 0);
+	    }
+	  else
+	    {
+	      ;
+	    }
 	  
 	  if (f >= 0)
 	    {
@@ -4960,21 +5014,14 @@ do_include (cppReader *pfile, struct directive *keyword,
     ** If so, give up.
     */
 
-    struct file_name_list *ptr;
-
-    for (ptr = pfile->all_include_files; ptr != NULL; ptr = ptr->next)
-      {
-	if (cstring_equal (ptr->fname, fname))
-	  {
-	    /* This file was included before.  */
-	    break;
-	  }
-      }
+    struct file_name_list *ptr = lookup_include_file (pfile, fname);
 
     if (ptr == NULL)
       {
 	/* This is the first time for this file.  */
 	/* Add it to list of files included.  */
+	int h = cpphash_hashCode (cstring_toCharsSafe (fname), cstring_length (fname),
+				  CPP_INCLUDEHASHSIZE);
 
 	ptr = (struct file_name_list *) dmalloc (sizeof (*ptr));
 	ptr->control_macro = NULL;
@@ -4982,6 +5029,8 @@ do_include (cppReader *pfile, struct directive *keyword,
 	ptr->next = pfile->all_include_files;
 	ptr->fname = fname;
 	ptr->got_name_map = NULL;
+	ptr->hash_next = pfile->all_include_hash[h];
+	pfile->all_include_hash[h] = ptr;
 
 	DPRINTF (("Including file: %s", fname));
 	pfile->all_include_files = ptr;
@@ -5001,7 +5050,7 @@ do_include (cppReader *pfile, struct directive *keyword,
       }
 
     if (finclude (pfile, f, fname, is_system_include (pfile, fname),
-		  searchptr != dsp ? searchptr : SELF_DIR_DUMMY))
+		  searchptr != dsp ? searchptr : SELF_DIR_DUMMY, TRUE))
       {
 	output_line_command (pfile, 0, enter_file);
 	pfile->only_seen_white = 2;
@@ -5024,19 +5073,49 @@ do_include (cppReader *pfile, struct directive *keyword,
 static bool
 redundant_include_p (cppReader *pfile, cstring name)
 {
-  struct file_name_list *l = pfile->all_include_files;
+  struct file_name_list *l = lookup_include_file (pfile, name);
 
-  for (; l != NULL; l = l->next)
-    {
-      if (cstring_equal (name, l->fname)
+  return (l != NULL
 	  && (l->control_macro != NULL)
-	  && (cpphash_lookup (l->control_macro, -1, -1) != NULL))
+	  && (cpphash_lookup (l->control_macro, -1, -1) != NULL));
+}
+
+/* Return the entry for NAME in all_include_files, or NULL if it has
+   not been included.  */
+
+static /*@null@*/ /*@exposed@*/ struct file_name_list *
+lookup_include_file (cppReader *pfile, cstring name)
+{
+  struct file_name_list *l;
+
+  if (cstring_isUndefined (name))
+    {
+      return NULL;
+    }
+
+  l = pfile->all_include_hash[cpphash_hashCode (cstring_toCharsSafe (name),
+						cstring_length (name),
+						CPP_INCLUDEHASHSIZE)];
+
+  for (; l != NULL; l = l->hash_next)
+    {
+      if (cstring_equal (name, l->fname))
 	{
-	  return TRUE;
+	  return l;
 	}
     }
 
-  return FALSE;
+  return NULL;
+}
+
+/* Return true if the include file candidate NAME has already failed
+   to open.  */
+
+static bool
+is_missing_include (cppReader *pfile, cstring name)
+{
+  return (cstringTable_isDefined (pfile->missing_includes)
+	  && cstringTable_lookup (pfile->missing_includes, name) != NOT_FOUND);
 }
 
 /* Return nonzero if the given FILENAME is an absolute pathname which
@@ -5968,15 +6047,12 @@ do_endif (cppReader *pfile, /*@unused@*/ struct directive *keyword,
 
 		 Do not do this for the top-level file in a -include or any
 		 file in a -imacros.  */
-	      struct file_name_list *ifile = pfile->all_include_files;
+	      struct file_name_list *ifile
+		= lookup_include_file (pfile, cppReader_getBufferSafe (pfile)->fname);
 
-	      for ( ; ifile != NULL; ifile = ifile->next)
+	      if (ifile != NULL)
 		{
-		  if (cstring_equal (ifile->fname, cppReader_getBufferSafe (pfile)->fname))
-		    {
-		      ifile->control_macro = temp->control_macro;
-		      break;
-		    }
+		  ifile->control_macro = temp->control_macro;
 		}
 	    }
 	}
@@ -7098,6 +7174,8 @@ open_include_file (cppReader *pfile,
    function above).
    DIRPTR is the link in the dir path through which this file was found,
    or 0 if the file name was absolute or via the current directory.
+   INCLUDED is TRUE if the file was named by #include; only those are
+   kept for reuse, since the main input files are read only once.
    Return 1 on success, 0 on failure.
 
    The caller is responsible for the cppReader_pushBuffer.  */
@@ -7106,15 +7184,17 @@ static int
 finclude (cppReader *pfile, int f,
 	  cstring fname,
 	  bool system_header_p,
-	  /*@dependent@*/ struct file_name_list *dirptr)
+	  /*@dependent@*/ struct file_name_list *dirptr,
+	  bool included)
 {
   mode_t st_mode; /* was __mode_t */
   size_t st_size;
+  time_t mtime;
   long i;
   int length = 0;
   cppBuffer *fp;			/* For input stack frame */
 
-  if (file_size_and_mode (f, &st_mode, &st_size) < 0)
+  if (file_size_and_mode (f, &st_mode, &st_size, &mtime) < 0)
     {
       cppReader_perrorWithName (pfile, fname);
       check (close (f) == 0);
@@ -7143,11 +7223,28 @@ finclude (cppReader *pfile, int f,
       fp->alimit = fp->buf + st_size + 2;
       fp->cur = fp->buf;
 
-      /* Read the file contents, knowing that st_size is an upper bound
-	 on the number of bytes we can read.  */
-      length = safe_read (f, fp->buf, size_toInt (st_size));
-      fp->rlimit = fp->buf + length;
-      if (length < 0) goto nope;
+      /*
+      ** Headers are included again by each file that uses them, so
+      ** reuse the contents read the first time if the file has not
+      ** changed since.
+      */
+
+      length = included
+	? lookup_file_contents (pfile, fname, st_size, mtime, fp->buf) : -1;
+
+      if (length < 0)
+	{
+	  /* Read the file contents, knowing that st_size is an upper bound
+	     on the number of bytes we can read.  */
+	  length = safe_read (f, fp->buf, size_toInt (st_size));
+	  fp->rlimit = fp->buf + length;
+	  if (length < 0) goto nope;
+
+	  if (included)
+	    {
+	      save_file_contents (pfile, fname, st_size, mtime, fp->buf, length);
+	    }
+	}
     }
   else if (S_ISDIR (st_mode))
     {
@@ -7283,6 +7380,21 @@ cppCleanup (/*@special@*/ cppReader *pfile)
       sfree (temp);
     }
 
+  memset (pfile->all_include_hash, 0, sizeof (pfile->all_include_hash));
+
+  if (cstringTable_isDefined (pfile->missing_includes))
+    {
+      cstringTable_free (pfile->missing_includes);
+      pfile->missing_includes = cstringTable_undefined;
+    }
+
+  if (genericTable_isDefined (pfile->file_contents))
+    {
+      genericTable_free (pfile->file_contents);
+      pfile->file_contents = genericTable_undefined;
+      pfile->file_contents_size = 0;
+    }
+
   /* evans 2002-07-12 */
   while (pfile->opts->map_list != NULL)
     {
@@ -7311,13 +7423,15 @@ cppCleanup (/*@special@*/ cppReader *pfile)
 */
 
 static int
-file_size_and_mode (int fd, mode_t *mode_pointer, size_t *size_pointer)
+file_size_and_mode (int fd, mode_t *mode_pointer, size_t *size_pointer,
+		    time_t *mtime_pointer)
 {
   struct stat sbuf;
 
   if (fstat (fd, &sbuf) < 0) {
     *mode_pointer = 0;
     *size_pointer = 0;
+    *mtime_pointer = 0;
     /*@-compdestroy@*/ /* possibly spurious warnings here (or memory leak) */
     return (-1);
     /*@=compdestroy@*/
@@ -7335,6 +7449,11 @@ file_size_and_mode (int fd, mode_t *mode_pointer, size_t *size_pointer)
       *size_pointer = (size_t) sbuf.st_size;
     }
 
+  if (mtime_pointer != NULL)
+    {
+      *mtime_pointer = sbuf.st_mtime;
+    }
+
   /*@-compdestroy@*/ /* possibly spurious warnings here (or memory leak) */
   return 0;
   /*@=compdestroy@*/
@@ -7379,6 +7498,71 @@ static int safe_read (int desc, char *ptr, int len)
   return len - left;
 }
 
+/* If the contents of FNAME were saved when it had size SIZE and
+   modification time MTIME, copy them into BUF and return their length.
+   Otherwise, return -1.  */
+
+static int
+lookup_file_contents (cppReader *pfile, cstring fname,
+		      size_t size, time_t mtime, char *buf)
+{
+  struct file_contents *fc;
+
+  if (genericTable_isUndefined (pfile->file_contents))
+    {
+      return -1;
+    }
+
+  fc = (struct file_contents *) genericTable_lookup (pfile->file_contents, fname);
+
+  if (fc == NULL || fc->size != size || fc->mtime != mtime)
+    {
+      return -1;
+    }
+
+  memcpy (buf, fc->contents, size_fromInt (fc->length));
+  return fc->length;
+}
+
+/* Save LENGTH bytes read from FNAME at BUF for lookup_file_contents.
+   A file that changed since it was saved keeps the old entry (which no
+   longer matches), and nothing more is saved once CPP_CONTENTS_MAX
+   bytes are held.  */
+
+static void
+save_file_contents (cppReader *pfile, cstring fname,
+		    size_t size, time_t mtime, char *buf, int length)
+{
+  struct file_contents *fc;
+
+  if (pfile->file_contents_size + size_fromInt (length) > CPP_CONTENTS_MAX)
+    {
+      return;
+    }
+
+  if (genericTable_isUndefined (pfile->file_contents))
+    {
+      pfile->file_contents = genericTable_create (CPP_INCLUDEHASHSIZE);
+    }
+  else if (genericTable_contains (pfile->file_contents, fname))
+    {
+      return;
+    }
+  else
+    {
+      ;
+    }
+
+  fc = (struct file_contents *) dmalloc (sizeof (*fc) + size_fromInt (length));
+  fc->size = size;
+  fc->mtime = mtime;
+  fc->length = length;
+  memcpy (fc->contents, buf, size_fromInt (length));
+
+  pfile->file_contents_size += size_fromInt (length);
+  genericTable_insert (pfile->file_contents, cstring_copy (fname), (void *) fc);
+}
+
 /* Initialize PMARK to remember the current position of PFILE.  */
 
 void
@@ -7782,7 +7966,7 @@ int cppReader_startProcess (cppReader *pfile, cstring fname)
       ;
     }
 
-  if (finclude (pfile, f, fname, 0, NULL))
+  if (finclude (pfile, f, fname, 0, NULL, FALSE))
     {
       output_line_command (pfile, 0, same_file);
     }
@@ -38,7 +38,16 @@
 static int lminput (void);
 static int s_tokLength = 0;
 
-static /*@owned@*/ cstring s_lastidprocessed = cstring_undefined;
+static /*@observer@*/ cstring s_lastidprocessed = cstring_undefined;
+
+/*
+** Identifiers are scanned into one of two buffers: the one holding the
+** last identifier processed must stay valid while the next is scanned.
+** Identifiers that are stored must be copied.
+*/
+
+static /*@only@*/ /*@null@*/ char *s_idbuffers[2] = { NULL, NULL };
+static size_t s_idbuffersizes[2] = { 0, 0 };
 static bool s_inSpecPart = FALSE;
 static int s_whichSpecPart;
 static char s_savechar = '\0';
@@ -180,6 +189,160 @@ static bool isArtificial (cstring s)
 	  || cstring_equalLit (s, "alt"));
 }
 
+/*
+** Identifiers with a special meaning under +gnuextensions.
+*/
+
+typedef enum
+{
+  GNU_NONE,       /* not special */
+  GNU_IGNORE,     /* ignored (e.g., __stdcall) */
+  GNU_TOKEN,      /* alternate spelling of a token (e.g., __const__) */
+  GNU_FUNCNAME,   /* name of the current function (e.g., __FUNCTION__) */
+  GNU_SKIP        /* followed by text that is skipped (e.g., __attribute__) */
+} gnuKind;
+
+struct sgnuword
+{
+  /*@null@*/ /*@observer@*/ char *name;
+  gnuKind kind;
+  int token;
+} ;
+
+static struct sgnuword s_gnutable[] = {
+  { "__stdcall", GNU_IGNORE, BADTOK } ,
+  { "__cdecl", GNU_IGNORE, BADTOK } ,
+  { "__extension__", GNU_IGNORE, BADTOK } ,
+  { "__volatile__", GNU_TOKEN, QVOLATILE } ,
+  { "__signed", GNU_TOKEN, QSIGNED } ,
+  { "__unsigned", GNU_TOKEN, QUNSIGNED } ,
+  { "__const__", GNU_TOKEN, QCONST } ,
+  { "__alignof__", GNU_TOKEN, CALIGNOF } , /* alignof is parsed like sizeof */
+  { "__typeof__", GNU_TOKEN, CTYPEOF } ,
+  { "typeof", GNU_TOKEN, CTYPEOF } ,
+  { "inline", GNU_TOKEN, QINLINE } ,
+  { "__inline", GNU_TOKEN, QINLINE } ,
+  { "_inline", GNU_TOKEN, QINLINE } ,
+  { "__inline__", GNU_TOKEN, QINLINE } ,
+  { "__FUNCTION__", GNU_FUNCNAME, BADTOK } ,
+  { "__PRETTY_FUNCTION__", GNU_FUNCNAME, BADTOK } ,
+  { "__attribute__", GNU_SKIP, BADTOK } ,
+  { "__asm__", GNU_SKIP, BADTOK } ,
+  { "_asm", GNU_SKIP, BADTOK } ,
+  { "__asm", GNU_SKIP, BADTOK } ,
+  { "__declspec", GNU_SKIP, BADTOK } ,
+  { NULL, GNU_NONE, BADTOK } 
+} ;
+
+/*
+** Every identifier is classified against s_parsetable, s_keytable and
+** s_gnutable, so the names in all three are entered in one open hash
+** table (built on first use) and looked up with a single probe.
+*/
+
+struct sidentifier
+{
+  /*@null@*/ /*@observer@*/ char *name;
+  int parsetoken;   /* token in s_parsetable, or BADTOK */
+  int keytoken;     /* token in s_keytable, or BADTOK */
+  gnuKind gnukind;
+  int gnutoken;
+} ;
+
+/*@constant int SPECIALIDTABLESIZE;@*/
+# define SPECIALIDTABLESIZE 512
+
+static struct sidentifier s_idtable[SPECIALIDTABLESIZE];
+static bool s_idtableLoaded = FALSE;
+
+static unsigned int specialId_hash (char *s)
+{
+  unsigned int h = 0;
+
+  while (*s != '\0')
+    {
+      h = (h * 31) + (unsigned int) *s;
+      s++;
+    }
+
+  return h & (SPECIALIDTABLESIZE - 1);
+}
+
+static /*@exposed@*/ struct sidentifier *specialId_find (char *s)
+{
+  unsigned int h = specialId_hash (s);
+
+  while (s_idtable[h].name != NULL && strcmp (s_idtable[h].name, s) != 0)
+    {
+      h = (h + 1) & (SPECIALIDTABLESIZE - 1);
+    }
+
+  return &s_idtable[h];
+}
+
+static /*@exposed@*/ struct sidentifier *specialId_add (/*@observer@*/ char *s)
+{
+  struct sidentifier *sid = specialId_find (s);
+
+  if (sid->name == NULL)
+    {
+      sid->name = s;
+      sid->parsetoken = BADTOK;
+      sid->keytoken = BADTOK;
+      sid->gnukind = GNU_NONE;
+      sid->gnutoken = BADTOK;
+    }
+
+  return sid;
+}
+
+static void specialId_loadTable (void)
+{
+  int i;
+
+  for (i = 0; s_parsetable[i].name != NULL; i++)
+    {
+      specialId_add (s_parsetable[i].name)->parsetoken = s_parsetable[i].token;
+    }
+
+  for (i = 0; s_keytable[i].name != NULL; i++)
+    {
+      specialId_add (s_keytable[i].name)->keytoken = s_keytable[i].token;
+    }
+
+  for (i = 0; s_gnutable[i].name != NULL; i++)
+    {
+      struct sidentifier *sid = specialId_add (s_gnutable[i].name);
+
+      sid->gnukind = s_gnutable[i].kind;
+      sid->gnutoken = s_gnutable[i].token;
+    }
+
+  s_idtableLoaded = TRUE;
+}
+
+/*
+** Returns the entry for s, or NULL if s is not special.
+*/
+
+static /*@null@*/ /*@exposed@*/ struct sidentifier *specialId_lookup (cstring s)
+{
+  struct sidentifier *sid;
+
+  if (cstring_isUndefined (s))
+    {
+      return NULL;
+    }
+
+  if (!s_idtableLoaded)
+    {
+      specialId_loadTable ();
+    }
+
+  sid = specialId_find (cstring_toCharsSafe (s));
+  return (sid->name == NULL) ? NULL : sid;
+}
+
 void cscannerHelp_swallowMacro (void)
 {
   int i;
@@ -219,121 +382,116 @@ void cscannerHelp_swallowMacro (void)
 
 static int commentMarkerToken (cstring s)
 {
-  int i = 0;
-  
-  while (s_parsetable[i].name != NULL) 
-    {
-      DPRINTF (("Try :%s:%s:", s, s_parsetable[i].name));
+  struct sidentifier *sid = specialId_lookup (s);
 
-      if (cstring_equalLit (s, s_parsetable[i].name))
-	{
-	  return s_parsetable[i].token;
-	}
+  return (sid == NULL) ? BADTOK : sid->parsetoken;
+}
 
-      i++;
+/*
+** Returns the token for sid as a stylized comment keyword (s_keytable),
+** or BADTOK.
+*/
+
+static int specialId_keyToken (/*@null@*/ struct sidentifier *sid)
+{
+  int token;
+
+  if (sid == NULL || sid->keytoken == BADTOK)
+    {
+      return BADTOK;
     }
 
-  return BADTOK;
-}
+  token = sid->keytoken;
 
-static int tokenMacroCode (cstring s)
-{
-  int i = 0;
-  
-  while (s_keytable[i].name != NULL) 
+  if (token == QLINTFALLTHROUGH) 
     {
-      if (cstring_equalLit (s, s_keytable[i].name)) 
-	{
-	  if (s_keytable[i].token == QLINTFALLTHROUGH) 
-	    {
-	      voptgenerror
-		(FLG_WARNLINTCOMMENTS,
-		 cstring_makeLiteral
-		 ("Traditional lint comment /*FALLTHROUGH*/ used. "
-		  "Splint interprets this in the same way as most Unix lints, but it is "
-		  "preferable to replace it with the /*@fallthrough@*/ "
-		  "semantic comment"),
-		 g_currentloc);
-	      return QFALLTHROUGH;	      
-	    }
-	  else if (s_keytable[i].token == QLINTFALLTHRU)
-	    {
-	      voptgenerror 
-		(FLG_WARNLINTCOMMENTS,
-		 cstring_makeLiteral
-		 ("Traditional lint comment /*FALLTHRU*/ used. "
-		  "Splint interprets this in the same way as most Unix lints, but it is "
-		  "preferable to replace it with the /*@fallthrough@*/ "
-		  "semantic comment"),
-		 g_currentloc);
-	      return QFALLTHROUGH;
-	    }
-	  else if (s_keytable[i].token == QLINTNOTREACHED)
-	    {
-	      voptgenerror 
-		(FLG_WARNLINTCOMMENTS,
-		 cstring_makeLiteral
-		 ("Traditional lint comment /*NOTREACHED*/ used. "
-		  "Splint interprets this in the same way as most Unix lints, but it is "
-		  "preferable to replace it with the /*@notreached@*/ "
-		  "semantic comment."),
-		 g_currentloc);
+      voptgenerror
+	(FLG_WARNLINTCOMMENTS,
+	 cstring_makeLiteral
+	 ("Traditional lint comment /*FALLTHROUGH*/ used. "
+	  "Splint interprets this in the same way as most Unix lints, but it is "
+	  "preferable to replace it with the /*@fallthrough@*/ "
+	  "semantic comment"),
+	 g_currentloc);
+      return QFALLTHROUGH;            
+    }
+  else if (token == QLINTFALLTHRU)
+    {
+      voptgenerror 
+	(FLG_WARNLINTCOMMENTS,
+	 cstring_makeLiteral
+	 ("Traditional lint comment /*FALLTHRU*/ used. "
+	  "Splint interprets this in the same way as most Unix lints, but it is "
+	  "preferable to replace it with the /*@fallthrough@*/ "
+	  "semantic comment"),
+	 g_currentloc);
+      return QFALLTHROUGH;
+    }
+  else if (token == QLINTNOTREACHED)
+    {
+      voptgenerror 
+	(FLG_WARNLINTCOMMENTS,
+	 cstring_makeLiteral
+	 ("Traditional lint comment /*NOTREACHED*/ used. "
+	  "Splint interprets this in the same way as most Unix lints, but it is "
+	  "preferable to replace it with the /*@notreached@*/ "
+	  "semantic comment."),
+	 g_currentloc);
 	      
-	      return QNOTREACHED;
-	    }
-	  else if (s_keytable[i].token == QPRINTFLIKE)
-	    {
-	      setSpecialFunction (qual_createPrintfLike ());
-	      return SKIPTOK;
-	    }
-	  else if (s_keytable[i].token == QLINTPRINTFLIKE)
-	    {	      
-	      voptgenerror 
-		(FLG_WARNLINTCOMMENTS,
-		 cstring_makeLiteral
-		 ("Traditional lint comment /*PRINTFLIKE*/ used. "
-		  "Splint interprets this in the same way as most Unix lints, but it is "
-		  "preferable to replace it with either /*@printflike@*/, "
-		  "/*@scanflike@*/ or /*@messagelike@*/."),
-		 g_currentloc);
+      return QNOTREACHED;
+    }
+  else if (token == QPRINTFLIKE)
+    {
+      setSpecialFunction (qual_createPrintfLike ());
+      return SKIPTOK;
+    }
+  else if (token == QLINTPRINTFLIKE)
+    {         
+      voptgenerror 
+	(FLG_WARNLINTCOMMENTS,
+	 cstring_makeLiteral
+	 ("Traditional lint comment /*PRINTFLIKE*/ used. "
+	  "Splint interprets this in the same way as most Unix lints, but it is "
+	  "preferable to replace it with either /*@printflike@*/, "
+	  "/*@scanflike@*/ or /*@messagelike@*/."),
+	 g_currentloc);
 	      
-	      setSpecialFunction (qual_createPrintfLike ());
-	      return SKIPTOK;
-	    }
-	  else if (s_keytable[i].token == QSCANFLIKE)
-	    {
-	      setSpecialFunction (qual_createScanfLike ());
-	      return SKIPTOK;
-	    }
-	  else if (s_keytable[i].token == QMESSAGELIKE)
-	    {
-	      setSpecialFunction (qual_createMessageLike ());
-	      return SKIPTOK;
-	    }
-	  else if (s_keytable[i].token == QARGSUSED)
-	    {
-	      voptgenerror
-		(FLG_WARNLINTCOMMENTS,
-		 cstring_makeLiteral
-		 ("Traditional lint comment /*ARGSUSED*/ used. "
-		  "Splint interprets this in the same way as most Unix lints, but it is "
-		  "preferable to use /*@unused@*/ annotations on "
-		  "the unused parameters."),
-		 g_currentloc);
+      setSpecialFunction (qual_createPrintfLike ());
+      return SKIPTOK;
+    }
+  else if (token == QSCANFLIKE)
+    {
+      setSpecialFunction (qual_createScanfLike ());
+      return SKIPTOK;
+    }
+  else if (token == QMESSAGELIKE)
+    {
+      setSpecialFunction (qual_createMessageLike ());
+      return SKIPTOK;
+    }
+  else if (token == QARGSUSED)
+    {
+      voptgenerror
+	(FLG_WARNLINTCOMMENTS,
+	 cstring_makeLiteral
+	 ("Traditional lint comment /*ARGSUSED*/ used. "
+	  "Splint interprets this in the same way as most Unix lints, but it is "
+	  "preferable to use /*@unused@*/ annotations on "
+	  "the unused parameters."),
+	 g_currentloc);
 	      
-	      setArgsUsed ();
-	      return SKIPTOK;
-	    }
-	  else
-	    {
-	      return s_keytable[i].token;
-	    }
-	}
-
-      i++;
+      setArgsUsed ();
+      return SKIPTOK;
     }
-  
-  return BADTOK;
+  else
+    {
+      return token;
+    }
+}
+
+static int tokenMacroCode (cstring s)
+{
+  return specialId_keyToken (specialId_lookup (s));
 }
 
 static int lminput ()
@@ -1452,10 +1610,29 @@ int cscannerHelp_handleLlSpecial (void)
   return BADTOK;
 }
 
-/*@only@*/ cstring cscannerHelp_makeIdentifier (char *s)
+/*@observer@*/ cstring cscannerHelp_makeIdentifier (char *s)
 {
-  char *c = mstring_create (strlen (s) + 1);
-  cstring id = cstring_fromChars (c);
+  size_t len = strlen (s) + 1;
+  int which;
+  char *c;
+  cstring id;
+
+  /*@access cstring@*/
+  which = (s_lastidprocessed == s_idbuffers[0]) ? 1 : 0;
+  /*@noaccess cstring@*/
+
+  if (s_idbuffersizes[which] < len)
+    {
+      size_t newsize = (len < 64) ? 64 : len;
+
+      sfree (s_idbuffers[which]);
+      s_idbuffers[which] = mstring_create (newsize);
+      s_idbuffersizes[which] = newsize;
+    }
+
+  c = s_idbuffers[which];
+  llassert (c != NULL);
+  id = cstring_fromChars (c);
 
   while (isalnum (*s) || (*s == '_') || (*s == '$')) 
     {
@@ -1519,18 +1696,14 @@ int cscannerHelp_handleLlSpecial (void)
   return res;
 }
 
-static void cscanner_setLastIdentifier (/*@keep@*/ cstring id) /*@modifies s_lastidprocessed@*/
+static void cscanner_setLastIdentifier (/*@observer@*/ cstring id) /*@modifies s_lastidprocessed@*/
 {
-  if (cstring_isDefined (s_lastidprocessed))
-    {
-      cstring_free (s_lastidprocessed); 
-    }
-
   s_lastidprocessed = id;
 }
 
 int cscannerHelp_processIdentifier (cstring id)
 {
+  struct sidentifier *sid = specialId_lookup (id);
   uentry le;
 
   if (context_getFlag (FLG_GRAMMAR))
@@ -1545,7 +1718,7 @@ int cscannerHelp_processIdentifier (cstring id)
 
   if (context_inFunctionHeader ())
     {
-      int tok = commentMarkerToken (id);
+      int tok = (sid == NULL) ? BADTOK : sid->parsetoken;
       DPRINTF (("in function decl: %s", id));
 
       if (tok != BADTOK)
@@ -1554,7 +1727,7 @@ int cscannerHelp_processIdentifier (cstring id)
 	}
       else 
 	{
-	  tok = tokenMacroCode (id);
+	  tok = specialId_keyToken (sid);
 	  
 	  if (tok != BADTOK)
 	    {
@@ -1601,44 +1774,19 @@ int cscannerHelp_processIdentifier (cstring id)
 
   if (context_getFlag (FLG_GNUEXTENSIONS))
     {
+      gnuKind kind = (sid == NULL) ? GNU_NONE : sid->gnukind;
       int tok = BADTOK;
       
-      if (cstring_equalLit (id, "__stdcall")
-	  || cstring_equalLit (id, "__cdecl")
-	  || cstring_equalLit (id, "__extension__"))
+      if (kind == GNU_IGNORE)
 	{
 	  return BADTOK;
 	}
-      else if (cstring_equalLit (id, "__volatile__"))
+      else if (kind == GNU_TOKEN)
 	{
-	  tok = QVOLATILE;
+	  llassert (sid != NULL);
+	  tok = sid->gnutoken;
 	}
-      else if (cstring_equalLit (id, "__signed"))
-	{
-	  tok = QSIGNED;
-	}
-      else if (cstring_equalLit (id, "__unsigned"))
-	{
-	  tok = QUNSIGNED;
-	}
-      else if (cstring_equalLit (id, "__const__"))
-	{
-	  tok = QCONST;
-	}
-      else if (cstring_equalLit (id, "__alignof__")) 
-	{
-	  tok = CALIGNOF; /* alignof is parsed like sizeof */
-	}
-      else if (cstring_equalLit (id, "__typeof__")) 
-	{
-	  tok = CTYPEOF;
-	}
-      else if (cstring_equalLit (id, "typeof")) 
-	{
-	  tok = CTYPEOF;
-	}
-      else if (cstring_equalLit (id, "__FUNCTION__")
-	       || cstring_equalLit (id, "__PRETTY_FUNCTION__")) 
+      else if (kind == GNU_FUNCNAME)
 	{
 	  /* These tokens hold the name of the current function as strings */
 	  /* evans 2001-12-30: changed from exprNode_stringLiteral; bug reported by Jim Zelenka. */
@@ -1648,11 +1796,7 @@ int cscannerHelp_processIdentifier (cstring id)
 	  tok = CCONSTANT;
 	  return tok;
 	}
-      else if (cstring_equalLit (id, "__attribute__")
-	       || cstring_equalLit (id, "__asm__")
-	       || cstring_equalLit (id, "_asm")
-	       || cstring_equalLit (id, "__asm")
-	       || cstring_equalLit (id, "__declspec"))
+      else if (kind == GNU_SKIP)
 	{
 	  int depth = 0;
 	  bool useparens = FALSE;
@@ -1759,13 +1903,6 @@ int cscannerHelp_processIdentifier (cstring id)
 
 	  return BADTOK;
 	}
-      else if (cstring_equalLit (id, "inline")
-	       || cstring_equalLit (id, "__inline")
-	       || cstring_equalLit (id, "_inline")
-	       || cstring_equalLit (id, "__inline__"))
-	{
-	  tok = QINLINE;
-	}
       else
 	{
 	  ;
@@ -1843,7 +1980,7 @@ int cscannerHelp_processIdentifier (cstring id)
   /*@=dependenttrans@*/
 }
 
-bool cscannerHelp_processHashIdentifier (/*@only@*/ cstring id)
+bool cscannerHelp_processHashIdentifier (/*@observer@*/ cstring id)
 {
   if (context_inMacro () || context_inIterDef () ||
       context_inIterEnd ())
@@ -1870,7 +2007,6 @@ bool cscannerHelp_processHashIdentifier (/*@only@*/ cstring id)
       ** Will be handled by handleLlSpecial
       */
 
-      cstring_free (id);
       return FALSE;
     }
 }
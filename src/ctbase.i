@@ -47,6 +47,19 @@ abst_typedef /*@null@*/ struct s_ctbase *ctbase;
   ctype ptr;     /* type of pointer to me */
   ctype array;    /* type of array of me */
   cstring unparse; /* unparse me, if memoized */
+
+  /*
+  ** Memoized predicates (CTP_ bits): known marks the bits computed so
+  ** far, props holds their values.  The CTP_REAL bits and realtype
+  ** (ctype_dne if not yet computed) hold only for the type definitions
+  ** and access they were computed under (realepoch and realaccess).
+  */
+
+  int known;
+  int props;
+  ctype realtype;
+  int realepoch;
+  typeIdSet realaccess;
 } *ctentry ;
 
 typedef /*@only@*/ ctentry o_ctentry;
@@ -56,13 +69,63 @@ typedef struct {
   int nspace;
   /*@relnull@*/ /*@only@*/ o_ctentry *entries;
   /* memoize matches...maybe in context? */
+
+  /*
+  ** Hash index of the entries (below nhashed) used by cttable_addFullSafe
+  ** to find an equivalent entry.  Chains are linked through hashnext,
+  ** newest entry first.
+  */
+
+  int nhashed;
+  int hashsize;
+  /*@relnull@*/ /*@only@*/ int *hashfirst;
+  /*@relnull@*/ /*@only@*/ int *hashnext;
 } cttable ;
 
+/*@constant int CTK_HASHBASESIZE;@*/
+# define CTK_HASHBASESIZE 1024
+
+/*@constant int NOCTHASH;@*/
+# define NOCTHASH -1
+
+/*@constant int CTP_ABSTRACT;@*/
+# define CTP_ABSTRACT        0x001
+
+/*@constant int CTP_NUMABSTRACT;@*/
+# define CTP_NUMABSTRACT     0x002
+
+/*@constant int CTP_UNSIGNED;@*/
+# define CTP_UNSIGNED        0x004
+
+/*@constant int CTP_REALPOINTER;@*/
+# define CTP_REALPOINTER     0x010
+
+/*@constant int CTP_REALARRAY;@*/
+# define CTP_REALARRAY       0x020
+
+/*@constant int CTP_REALAP;@*/
+# define CTP_REALAP          0x040
+
+/*@constant int CTP_REALFUNCTION;@*/
+# define CTP_REALFUNCTION    0x080
+
+/*@constant int CTP_REALSU;@*/
+# define CTP_REALSU          0x100
+
+/*@constant int CTP_REALABSTRACT;@*/
+# define CTP_REALABSTRACT    0x200
+
+/*@constant int CTP_REALNUMABSTRACT;@*/
+# define CTP_REALNUMABSTRACT 0x400
+
+/*@constant int CTP_REALMASK;@*/
+# define CTP_REALMASK        0x7f0
+
 extern bool ctentry_isBogus (/*@sef@*/ ctentry p_c) /*@*/;
 # define ctentry_isBogus(c) \
    ((c)->kind == CTK_INVALID || (c)->kind == CTK_DNE)
 
-static cttable cttab = { 0, 0, NULL };
+static cttable cttab = { 0, 0, NULL, 0, 0, NULL, NULL };
 
 static /*@notnull@*/ /*@only@*/ ctbase ctbase_createAbstract (typeId p_u);
 static /*@notnull@*/ /*@only@*/ ctbase ctbase_createNumAbstract (typeId p_u);
@@ -74,11 +137,17 @@ static /*@only@*/ ctentry ctentry_makeNew (ctkind p_ctk, /*@only@*/ ctbase p_c);
 static /*@only@*/ cstring ctentry_unparse (ctentry p_c) /*@*/ ;
 
 static void cttable_grow (void);
+static void cttable_resetHash (void);
 static ctype cttable_addDerived (ctkind p_ctk, /*@keep@*/ ctbase p_cnew, ctype p_base);
 static ctype cttable_addFull (/*@keep@*/ ctentry p_cnew);
 static bool ctentry_isInteresting (ctentry p_c) /*@*/;
 static /*@notnull@*/ /*@only@*/ ctbase ctbase_makeFixedArray (ctype p_b, size_t p_size) /*@*/ ;
 static bool ctbase_isAnytype (/*@notnull@*/ ctbase p_b) /*@*/ ;
+static unsigned int ctbase_hashValue (/*@notnull@*/ ctbase p_c, int p_depth) /*@*/ ;
+static unsigned int ctype_hashValue (ctype p_c, int p_depth) /*@*/ ;
+
+/*@constant int CTBASE_HASHDEPTH;@*/
+# define CTBASE_HASHDEPTH 4
 
 /* 
 ** These are file-static macros (used in ctype.c).  No way to
@@ -2530,6 +2599,99 @@ static bool ctbase_equiv (/*@notnull@*/ ctbase c1, /*@notnull@*/ ctbase c2)
   return (ctbase_compare (c1, c2, FALSE) == 0);
 }
 
+/*
+** Hash values consistent with ctbase_equiv (and ctype_compare): equivalent
+** types always hash the same.  Nested types are only followed to a
+** limited depth.
+*/
+
+static unsigned int ctype_hashValue (ctype c, int depth)
+{
+  /*@+enumint@*/
+  if (c >= CT_FIRST && c < cttab.size)
+    {
+      ctentry cte = cttab.entries[c];
+
+      if (ctentry_isComplex (cte) && ctbase_isDefined (cte->ctbase))
+	{
+	  return ctbase_hashValue (cte->ctbase, depth);
+	}
+    }
+
+  return (unsigned int) c;
+  /*@=enumint@*/
+}
+
+static unsigned int 
+ctbase_hashListValue (unsigned int hash, uentryList l, int depth)
+{
+  int i;
+  int sz = uentryList_size (l);
+
+  hash = hash * 31 + (unsigned int) sz;
+
+  for (i = 0; i < sz; i++)
+    {
+      hash = hash * 31 + ctype_hashValue (uentry_getType (uentryList_getN (l, i)), 
+					  depth);
+    }
+
+  return hash;
+}
+
+static unsigned int ctbase_hashValue (/*@notnull@*/ ctbase c, int depth)
+{
+  unsigned int hash = (unsigned int) c->type;
+
+  if (depth >= CTBASE_HASHDEPTH)
+    {
+      return hash;
+    }
+
+  depth++;
+
+  switch (c->type)
+    {
+    case CT_UNKNOWN:
+    case CT_BOOL:
+    case CT_ENUMLIST:
+      break;
+    case CT_PRIM:
+      hash = hash * 31 + (unsigned int) c->contents.prim;
+      break;
+    case CT_USER:
+    case CT_ENUM:
+    case CT_ABST:
+    case CT_NUMABST:
+      hash = hash * 31 + (unsigned int) c->contents.tid;
+      break;
+    case CT_PTR:
+    case CT_ARRAY:
+    case CT_EXPFCN:
+      hash = hash * 31 + ctype_hashValue (c->contents.base, depth);
+      break;
+    case CT_FIXEDARRAY:
+      hash = hash * 31 + (unsigned int) c->contents.farray->size;
+      hash = hash * 31 + ctype_hashValue (c->contents.farray->base, depth);
+      break;
+    case CT_FCN:
+      hash = hash * 31 + ctype_hashValue (c->contents.fcn->rval, depth);
+      hash = ctbase_hashListValue (hash, c->contents.fcn->params, depth);
+      break;
+    case CT_STRUCT:
+    case CT_UNION:
+      hash = ctbase_hashListValue (hash, c->contents.su->fields, depth);
+      break;
+    case CT_CONJ:
+      hash = hash * 31 + ctype_hashValue (c->contents.conj->a, depth);
+      hash = hash * 31 + ctype_hashValue (c->contents.conj->b, depth);
+      hash = hash * 2 + (c->contents.conj->isExplicit ? 1 : 0);
+      break;
+    }
+
+  return hash;
+}
+
 static bool
 ctbase_isKind (/*@notnull@*/ ctbase c, ctuid kind)
 {
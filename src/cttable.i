@@ -63,10 +63,81 @@ static void cttable_reset (void)
       cttab.entries = NULL;
     }
 
+  cttable_resetHash ();
   cttab.size = 0 ;
   cttab.nspace = 0 ;
 }
 
+static void cttable_resetHash (void)
+   /*@globals cttab@*/
+   /*@modifies cttab@*/
+{
+  sfree (cttab.hashfirst);
+  sfree (cttab.hashnext);
+  cttab.hashfirst = NULL;
+  cttab.hashnext = NULL;
+  cttab.hashsize = 0;
+  cttab.nhashed = 0;
+}
+
+/*
+** Adds any entries not yet in the hash index.  The index is sized for
+** the allocated table, so it is rebuilt (by cttable_grow discarding it)
+** only when the table grows.
+*/
+
+static void cttable_updateHash (void)
+   /*@globals cttab@*/
+   /*@modifies cttab@*/
+{
+  int i;
+
+  if (cttab.hashfirst == NULL)
+    {
+      int capacity = cttab.size + cttab.nspace;
+
+      cttab.hashsize = CTK_HASHBASESIZE;
+
+      while (cttab.hashsize < capacity)
+	{
+	  cttab.hashsize *= 2;
+	}
+
+      cttab.hashfirst = (int *) dmalloc (sizeof (*cttab.hashfirst) * cttab.hashsize);
+      cttab.hashnext = (int *) dmalloc (sizeof (*cttab.hashnext) * capacity);
+
+      for (i = 0; i < cttab.hashsize; i++)
+	{
+	  cttab.hashfirst[i] = NOCTHASH;
+	}
+
+      cttab.nhashed = 0;
+    }
+
+  llassert (cttab.hashnext != NULL);
+
+  for (i = cttab.nhashed; i < cttab.size; i++)
+    {
+      ctbase ctb = cttab.entries[i]->ctbase;
+
+      /* Enum lists are never equivalent to anything. */
+
+      if (ctbase_isDefined (ctb) && ctb->type != CT_ENUMLIST)
+	{
+	  unsigned int h = ctbase_hashValue (ctb, 0) % (unsigned int) cttab.hashsize;
+
+	  cttab.hashnext[i] = cttab.hashfirst[h];
+	  cttab.hashfirst[h] = i;
+	}
+      else
+	{
+	  cttab.hashnext[i] = NOCTHASH;
+	}
+    }
+
+  cttab.nhashed = cttab.size;
+}
+
 static ctentry
 ctentry_makeNew (ctkind ctk, /*@only@*/ ctbase c)
 {
@@ -87,6 +158,11 @@ ctentry_make (ctkind ctk,
   cte->ptr = ptr;
   cte->array = array;
   cte->unparse = unparse;
+  cte->known = 0;
+  cte->props = 0;
+  cte->realtype = ctype_dne;
+  cte->realepoch = -1;
+  cte->realaccess = typeIdSet_undefined;
   return cte;
 }
 
@@ -484,7 +560,7 @@ cttable_grow ()
   int i;
   o_ctentry *newentries ;
 
-  cttab.nspace = CTK_BASESIZE;
+  cttab.nspace = cttab.size > CTK_BASESIZE ? cttab.size : CTK_BASESIZE;
   newentries = (ctentry *) dmalloc (sizeof (*newentries) * (cttab.size + cttab.nspace));
 
   if (newentries == NULL)
@@ -503,6 +579,7 @@ cttable_grow ()
   /*@=compdestroy@*/
 
   cttab.entries = newentries;
+  cttable_resetHash ();
 /*@-compdef@*/
 } /*@=compdef@*/
 
@@ -589,21 +666,28 @@ cttable_addFullSafe (/*@only@*/ ctentry cnew)
 
   llassert (ctbase_isDefined (cnewbase));
 
-  for (i = cttable_lastIndex (); i >= CT_FIRST; i--)
-    {
-      ctbase ctb = ctype_getCtbase (i);
+  if (cttab.nspace == 0)
+    cttable_grow ();
+
+  /*
+  ** Look for an equivalent entry, newest first.  Only entries in the
+  ** same hash chain can be equivalent.
+  */
+
+  cttable_updateHash ();
+  llassert (cttab.hashfirst != NULL && cttab.hashnext != NULL);
 
-      if (ctbase_isDefined (ctb) 
-	  && ctbase_equiv (cnewbase, ctype_getCtbaseSafe (i)))
+  for (i = cttab.hashfirst[ctbase_hashValue (cnewbase, 0) 
+			   % (unsigned int) cttab.hashsize];
+       i != NOCTHASH; i = cttab.hashnext[i])
+    {
+      if (ctbase_equiv (cnewbase, ctype_getCtbaseSafe (i)))
 	{
 	  ctentry_free (cnew);
 	  return i;
 	}
     }
 
-  if (cttab.nspace == 0)
-    cttable_grow ();
-
   /*drl bee: si*/  cttab.entries[cttab.size] = cnew;
 
   cttab.nspace--;
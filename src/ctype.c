@@ -50,6 +50,18 @@ static void ctype_recordConj (ctype p_c);
 static ctype ctype_getConjA (ctype p_c) /*@*/ ;
 static ctype ctype_getConjB (ctype p_c) /*@*/ ;
 
+/*
+** Incremented whenever a type definition (or the bool type) changes,
+** discarding the memoized real types and CTP_REAL predicates.
+*/
+
+static int s_realTypeEpoch = 0;
+
+static /*@null@*/ /*@dependent@*/ ctentry ctype_memoEntry (ctype p_c) /*@*/ ;
+static ynm ctype_knownProperty (ctype p_c, int p_prop) /*@modifies internalState@*/ ;
+static bool ctype_recordProperty (ctype p_c, int p_prop, bool p_val)
+   /*@modifies internalState@*/ ;
+
 static bool ctype_isComplex (ctype c)
 {
   return (ctentry_isComplex (ctype_getCtentry (c)));
@@ -177,9 +189,109 @@ ctype_count (void)
   return (cttab.size);
 }
 
+void
+ctype_invalidateRealTypes (void)
+{
+  s_realTypeEpoch++;
+}
+
+/*
+** Returns the entry holding the memoized properties of c, or NULL for
+** the special ctypes with no table entry.
+*/
+
+static /*@null@*/ /*@dependent@*/ ctentry
+ctype_memoEntry (ctype c)
+{
+  /*@+enumint@*/
+  if (c >= CTK_PLAIN && c < cttab.size)
+    {
+      return (cttab.entries[c]);
+    }
+  /*@=enumint@*/
+
+  return NULL;
+}
+
+static bool
+ctentry_isRealCurrent (/*@notnull@*/ ctentry cte)
+{
+  return (cte->realepoch == s_realTypeEpoch
+	  && cte->realaccess == context_currentAccess ());
+}
+
+/*
+** Discards the real type and CTP_REAL bits of cte if they were
+** computed under other type definitions or access.
+*/
+
+static void
+ctentry_refreshReal (/*@notnull@*/ ctentry cte)
+{
+  if (!ctentry_isRealCurrent (cte))
+    {
+      cte->known &= ~CTP_REALMASK;
+      cte->realtype = ctype_dne;
+      cte->realepoch = s_realTypeEpoch;
+      cte->realaccess = context_currentAccess ();
+    }
+}
+
+static ynm
+ctype_knownProperty (ctype c, int prop)
+{
+  ctentry cte = ctype_memoEntry (c);
+
+  if (cte == NULL)
+    {
+      return MAYBE;
+    }
+
+  if ((prop & CTP_REALMASK) != 0)
+    {
+      ctentry_refreshReal (cte);
+    }
+
+  if ((cte->known & prop) != 0)
+    {
+      return (ynm_fromBool ((cte->props & prop) != 0));
+    }
+
+  return MAYBE;
+}
+
+/*
+** Records val for prop unless the definitions or access it depends on
+** changed while computing it.  Returns val.
+*/
+
+static bool
+ctype_recordProperty (ctype c, int prop, bool val)
+{
+  ctentry cte = ctype_memoEntry (c);
+
+  if (cte != NULL
+      && ((prop & CTP_REALMASK) == 0 || ctentry_isRealCurrent (cte)))
+    {
+      cte->known |= prop;
+
+      if (val)
+	{
+	  cte->props |= prop;
+	}
+      else
+	{
+	  cte->props &= ~prop;
+	}
+    }
+
+  return val;
+}
+
 ctype
 ctype_realType (ctype c)
 {
+  ctentry cte;
   ctype r = c;
 
   if (ctype_isElips (c) || ctype_isMissingParamsMarker (c))
@@ -187,6 +299,18 @@ ctype_realType (ctype c)
       return c;
     }
 
+  cte = ctype_memoEntry (c);
+
+  if (cte != NULL)
+    {
+      ctentry_refreshReal (cte);
+
+      if (cte->realtype != ctype_dne)
+	{
+	  return cte->realtype;
+	}
+    }
+
   if (ctype_isUA (c))
     {
       r = uentry_getRealType (usymtab_getTypeEntry (ctype_typeId (c)));
@@ -199,6 +323,11 @@ ctype_realType (ctype c)
 	  r = context_boolImplementationType ();
 	}
     }
+
+  if (cte != NULL && ctentry_isRealCurrent (cte))
+    {
+      cte->realtype = r;
+    }
   
   return r;
 }
@@ -260,21 +389,39 @@ ctype_isUser (ctype c)
 bool
 ctype_isAbstract (ctype c)
 {
-  return (!ctype_isUnknown (c) 
-	  && ((ctype_isPlain (c) && ctbase_isAbstract (ctype_getCtbaseSafe (c))) ||
-	      (ctype_isConj (c) &&
-	       (ctype_isAbstract (ctype_getConjA (c)) 
-		|| ctype_isAbstract (ctype_getConjB (c))))));
+  ynm known = ctype_knownProperty (c, CTP_ABSTRACT);
+
+  if (!ynm_isMaybe (known))
+    {
+      return (ynm_toBoolStrict (known));
+    }
+
+  return (ctype_recordProperty
+	  (c, CTP_ABSTRACT,
+	   !ctype_isUnknown (c) 
+	   && ((ctype_isPlain (c) && ctbase_isAbstract (ctype_getCtbaseSafe (c))) ||
+	       (ctype_isConj (c) &&
+		(ctype_isAbstract (ctype_getConjA (c)) 
+		 || ctype_isAbstract (ctype_getConjB (c)))))));
 }
 
 bool
 ctype_isNumAbstract (ctype c)
 {
-  return (!ctype_isUnknown (c) 
-	  && ((ctype_isPlain (c) && ctbase_isNumAbstract (ctype_getCtbaseSafe (c))) ||
-	      (ctype_isConj (c) &&
-	       (ctype_isNumAbstract (ctype_getConjA (c)) 
-		|| ctype_isNumAbstract (ctype_getConjB (c))))));
+  ynm known = ctype_knownProperty (c, CTP_NUMABSTRACT);
+
+  if (!ynm_isMaybe (known))
+    {
+      return (ynm_toBoolStrict (known));
+    }
+
+  return (ctype_recordProperty
+	  (c, CTP_NUMABSTRACT,
+	   !ctype_isUnknown (c) 
+	   && ((ctype_isPlain (c) && ctbase_isNumAbstract (ctype_getCtbaseSafe (c))) ||
+	       (ctype_isConj (c) &&
+		(ctype_isNumAbstract (ctype_getConjA (c)) 
+		 || ctype_isNumAbstract (ctype_getConjB (c)))))));
 }
 
 bool
@@ -286,19 +433,37 @@ ctype_isImmutableAbstract (ctype t)
 bool
 ctype_isRealAbstract (ctype c)
 {
-  return (ctype_isAbstract (ctype_realType (c)) ||
-	  (ctype_isConj (c) && 
-	   (ctype_isRealAbstract (ctype_getConjA (c)) || 
-	    ctype_isRealAbstract (ctype_getConjB (c)))));
+  ynm known = ctype_knownProperty (c, CTP_REALABSTRACT);
+
+  if (!ynm_isMaybe (known))
+    {
+      return (ynm_toBoolStrict (known));
+    }
+
+  return (ctype_recordProperty
+	  (c, CTP_REALABSTRACT,
+	   ctype_isAbstract (ctype_realType (c)) ||
+	   (ctype_isConj (c) && 
+	    (ctype_isRealAbstract (ctype_getConjA (c)) || 
+	     ctype_isRealAbstract (ctype_getConjB (c))))));
 }
 
 bool
 ctype_isRealNumAbstract (ctype c)
 {
-  return (ctype_isNumAbstract (ctype_realType (c)) ||
-	  (ctype_isConj (c) && 
-	   (ctype_isRealNumAbstract (ctype_getConjA (c)) || 
-	    ctype_isRealNumAbstract (ctype_getConjB (c)))));
+  ynm known = ctype_knownProperty (c, CTP_REALNUMABSTRACT);
+
+  if (!ynm_isMaybe (known))
+    {
+      return (ynm_toBoolStrict (known));
+    }
+
+  return (ctype_recordProperty
+	  (c, CTP_REALNUMABSTRACT,
+	   ctype_isNumAbstract (ctype_realType (c)) ||
+	   (ctype_isConj (c) && 
+	    (ctype_isRealNumAbstract (ctype_getConjA (c)) || 
+	     ctype_isRealNumAbstract (ctype_getConjB (c))))));
 }
 
 /*
@@ -1053,50 +1218,96 @@ ctype_isRealBool (ctype c)
 bool
 ctype_isRealPointer (ctype c)
 {
+  ynm known = ctype_knownProperty (c, CTP_REALPOINTER);
+
+  if (!ynm_isMaybe (known))
+    {
+      return (ynm_toBoolStrict (known));
+    }
+
   if (ctype_isConj (c))
-    return (ctype_isRealPointer (ctype_getConjA (c)) ||
-	    ctype_isRealPointer (ctype_getConjB (c)));
-  return (ctype_isPointer (ctype_realType (c)));
+    return (ctype_recordProperty 
+	    (c, CTP_REALPOINTER,
+	     ctype_isRealPointer (ctype_getConjA (c)) ||
+	     ctype_isRealPointer (ctype_getConjB (c))));
+  return (ctype_recordProperty (c, CTP_REALPOINTER, ctype_isPointer (ctype_realType (c))));
 }
 
 bool
 ctype_isRealSU (ctype c)
 {
+  ynm known = ctype_knownProperty (c, CTP_REALSU);
+
+  if (!ynm_isMaybe (known))
+    {
+      return (ynm_toBoolStrict (known));
+    }
+
   if (ctype_isConj (c))
     {
-      return (ctype_isRealSU (ctype_getConjA (c)) ||
-	      ctype_isRealSU (ctype_getConjB (c)));
+      return (ctype_recordProperty 
+	      (c, CTP_REALSU,
+	       ctype_isRealSU (ctype_getConjA (c)) ||
+	       ctype_isRealSU (ctype_getConjB (c))));
     }
 
   DPRINTF (("Real su: %s / %s", ctype_unparse (c), ctype_unparse (ctype_realType (c))));
-  return (ctype_isStructorUnion (ctype_realType (c)));
+  return (ctype_recordProperty (c, CTP_REALSU,
+				ctype_isStructorUnion (ctype_realType (c))));
 }
   
 bool
 ctype_isRealArray (ctype c)
 {
+  ynm known = ctype_knownProperty (c, CTP_REALARRAY);
+
+  if (!ynm_isMaybe (known))
+    {
+      return (ynm_toBoolStrict (known));
+    }
+
   if (ctype_isConj (c))
-    return (ctype_isRealArray (ctype_getConjA (c)) ||
-	    ctype_isRealArray (ctype_getConjB (c)));
-  return (ctype_isArray (ctype_realType (c)));
+    return (ctype_recordProperty 
+	    (c, CTP_REALARRAY,
+	     ctype_isRealArray (ctype_getConjA (c)) ||
+	     ctype_isRealArray (ctype_getConjB (c))));
+  return (ctype_recordProperty (c, CTP_REALARRAY, ctype_isArray (ctype_realType (c))));
 }
 
 bool
 ctype_isRealAP (ctype c)
 {
+  ynm known = ctype_knownProperty (c, CTP_REALAP);
+
+  if (!ynm_isMaybe (known))
+    {
+      return (ynm_toBoolStrict (known));
+    }
+
   if (ctype_isConj (c))
-    return (ctype_isRealAP (ctype_getConjA (c)) ||
-	    ctype_isRealAP (ctype_getConjB (c)));
-  return (ctype_isAP (ctype_realType (c)));
+    return (ctype_recordProperty 
+	    (c, CTP_REALAP,
+	     ctype_isRealAP (ctype_getConjA (c)) ||
+	     ctype_isRealAP (ctype_getConjB (c))));
+  return (ctype_recordProperty (c, CTP_REALAP, ctype_isAP (ctype_realType (c))));
 }
 
 bool
 ctype_isRealFunction (ctype c)
 {
+  ynm known = ctype_knownProperty (c, CTP_REALFUNCTION);
+
+  if (!ynm_isMaybe (known))
+    {
+      return (ynm_toBoolStrict (known));
+    }
+
   if (ctype_isConj (c))
-    return (ctype_isRealFunction (ctype_getConjA (c)) ||
-	    ctype_isRealFunction (ctype_getConjB (c)));
-  return (ctype_isFunction (ctype_realType (c)));
+    return (ctype_recordProperty 
+	    (c, CTP_REALFUNCTION,
+	     ctype_isRealFunction (ctype_getConjA (c)) ||
+	     ctype_isRealFunction (ctype_getConjB (c))));
+  return (ctype_recordProperty (c, CTP_REALFUNCTION, ctype_isFunction (ctype_realType (c))));
 }
 
 bool
@@ -2693,8 +2904,19 @@ bool
 ctype_isUnsigned (ctype c)
 {
   if (ctype_isConj (c))
-    return (ctype_isUnsigned (ctype_getConjA (c)) ||
-	    ctype_isUnsigned (ctype_getConjB (c)));
+    {
+      ynm known = ctype_knownProperty (c, CTP_UNSIGNED);
+
+      if (!ynm_isMaybe (known))
+	{
+	  return (ynm_toBoolStrict (known));
+	}
+
+      return (ctype_recordProperty 
+	      (c, CTP_UNSIGNED,
+	       ctype_isUnsigned (ctype_getConjA (c)) ||
+	       ctype_isUnsigned (ctype_getConjB (c))));
+    }
 
   return (c == ctype_uint || c == ctype_uchar
 	  || c == ctype_usint || c == ctype_ulint
@@ -80,6 +80,7 @@ static void
 
 static /*@only@*/ exprNode exprNode_effect (exprNode p_e)
   /*@globals internalState@*/ ;
+static void exprNode_dealloc (/*@only@*/ exprNode p_e) /*@modifies internalState@*/ ;
 static /*@only@*/ cstring exprNode_doUnparse (exprNode p_e);
 static /*@observer@*/ cstring exprNode_rootVarName (exprNode p_e);
 static /*@exposed@*/ exprNode 
@@ -96,6 +97,27 @@ static int nowalloc = 0;
 static int totalloc = 0;
 static int maxalloc = 0;
 
+/*
+** exprNodes are allocated in blocks and recycled through a free list,
+** instead of one malloc and free per node.  Function bodies build and
+** discard many thousands of nodes, so after the first large function
+** nearly every node comes off the free list.  Blocks are only released
+** by exprNode_destroyMod.
+*/
+
+# define EXPRNODEBLOCKSIZE 256
+
+typedef struct s_exprNodeBlock
+{
+  /*@only@*/ struct s_exprNodeBlock *next;
+  struct s_exprNode nodes[EXPRNODEBLOCKSIZE];
+} *exprNodeBlock;
+
+static /*@only@*/ /*@null@*/ exprNodeBlock s_nodeBlocks = NULL;
+static /*@only@*/ /*@null@*/ exprNode *s_freeNodes = NULL;
+static int s_nfreeNodes = 0;
+static int s_freeNodesSpace = 0;
+
 static /*@only@*/ uentry regArg;
 static /*@only@*/ uentry outArg;
 static /*@only@*/ uentry outStringArg;
@@ -228,6 +250,21 @@ exprNode_destroyMod (void)
       
       exprNode_free (s_mustExitNode);
       initMod = FALSE;
+
+      if (nowalloc == 0)
+	{
+	  while (s_nodeBlocks != NULL)
+	    {
+	      exprNodeBlock next = s_nodeBlocks->next;
+	      sfree (s_nodeBlocks);
+	      s_nodeBlocks = next;
+	    }
+
+	  sfree (s_freeNodes);
+	  s_freeNodes = NULL;
+	  s_nfreeNodes = 0;
+	  s_freeNodesSpace = 0;
+	}
       /*@-branchstate@*/ 
     } 
   /*@=branchstate@*/
@@ -324,7 +361,7 @@ exprNode_freeIniter (/*@only@*/ exprNode e)
       e->trueEnsuresConstraints = NULL;
       e->falseEnsuresConstraints = NULL;
 	
-      sfree (e);
+      exprNode_dealloc (e);
     }
 }
 
@@ -363,8 +400,7 @@ exprNode_freeShallow (/*@only@*/ exprNode e)
 		  sRefSet_free (e->msets);
 		  guardSet_free (e->guards);
 		  exprData_freeShallow (e->edata, e->kind); 
-		  nowalloc--;
-		  /*@-compdestroy@*/ sfree (e); /*@=compdestroy@*/
+		  /*@-compdestroy@*/ exprNode_dealloc (e); /*@=compdestroy@*/
 		  /*@-branchstate@*/
 		}
 	    }
@@ -398,8 +434,7 @@ exprNode_free (exprNode e)
 	  e->trueEnsuresConstraints = NULL;
 	  e->falseEnsuresConstraints = NULL;
 	
-	  nowalloc--;
-	  sfree (e);
+	  exprNode_dealloc (e);
 	  /*@-branchstate@*/ 
 	} /*@=branchstate@*/
     }
@@ -411,11 +446,66 @@ exprNode_makeError ()
   return exprNode_undefined;
 }
 
+static void exprNode_growFreeNodes (void)
+   /*@globals s_freeNodes, s_nfreeNodes, s_freeNodesSpace@*/
+   /*@modifies s_freeNodes, s_freeNodesSpace@*/
+{
+  if (s_freeNodesSpace == 0)
+    {
+      s_freeNodesSpace = EXPRNODEBLOCKSIZE;
+    }
+  else
+    {
+      s_freeNodesSpace *= 2;
+    }
+
+  s_freeNodes = (exprNode *) drealloc (s_freeNodes, 
+				       sizeof (*s_freeNodes) * s_freeNodesSpace);
+}
+
+static void 
+exprNode_dealloc (/*@only@*/ exprNode e)
+   /*@globals s_freeNodes, s_nfreeNodes, s_freeNodesSpace, nowalloc@*/
+   /*@modifies s_freeNodes, s_nfreeNodes, s_freeNodesSpace, nowalloc@*/
+{
+  if (s_nfreeNodes >= s_freeNodesSpace)
+    {
+      exprNode_growFreeNodes ();
+    }
+
+  llassert (s_freeNodes != NULL);
+  /*@-compdestroy@*/ s_freeNodes[s_nfreeNodes++] = e; /*@=compdestroy@*/
+  nowalloc--;
+}
+
 static /*@out@*/ /*@only@*/ /*@notnull@*/ exprNode
 exprNode_new (void)
 {
-  exprNode ret = (exprNode) dmalloc (sizeof (*ret));
-  /* static int lastexpnodes = 0; */
+  exprNode ret;
+
+  if (s_nfreeNodes == 0)
+    {
+      exprNodeBlock block = (exprNodeBlock) dmalloc (sizeof (*block));
+      int i;
+
+      block->next = s_nodeBlocks;
+      s_nodeBlocks = block;
+
+      while (s_freeNodesSpace < EXPRNODEBLOCKSIZE)
+	{
+	  exprNode_growFreeNodes ();
+	}
+
+      llassert (s_freeNodes != NULL);
+
+      for (i = EXPRNODEBLOCKSIZE - 1; i >= 0; i--)
+	{
+	  s_freeNodes[s_nfreeNodes++] = &block->nodes[i];
+	}
+    }
+
+  llassert (s_freeNodes != NULL);
+  ret = s_freeNodes[--s_nfreeNodes];
 
   nowalloc++;
   totalloc++;
@@ -9503,21 +9593,93 @@ static /*@observer@*/ cstring exprNode_rootVarName (exprNode e)
   return ret;
 }
 
-static /*@only@*/ cstring exprNode_doUnparse (exprNode e)
+/*
+** Expression text is built in a single pass into one growing buffer.
+** Subexpressions append their text directly instead of producing
+** (and caching) their own concatenated copies, so unparsing a deeply
+** nested expression no longer leaves a full copy of each subtree's text
+** on every node.  Text already cached on a subexpression is reused.
+*/
+
+typedef struct
 {
-  cstring ret;
-  exprData data;
+  /*@only@*/ /*@null@*/ char *chars;
+  size_t len;
+  size_t size;
+} unparseBuffer;
+
+# define UNPARSEBUFFERBASESIZE 64
+
+static void unparseBuffer_appendLength (unparseBuffer *p_buf, 
+					/*@null@*/ const char *p_s, size_t p_len)
+   /*@modifies *p_buf@*/ ;
+static void unparseBuffer_append (unparseBuffer *p_buf, cstring p_s)
+   /*@modifies *p_buf@*/ ;
+static void unparseBuffer_appendFree (unparseBuffer *p_buf, /*@only@*/ cstring p_s)
+   /*@modifies *p_buf@*/ ;
+static void exprNode_unparseAppend (unparseBuffer *p_buf, /*@temp@*/ exprNode p_e)
+   /*@modifies *p_buf@*/ ;
+static void exprNodeList_unparseAppend (unparseBuffer *p_buf, exprNodeList p_s)
+   /*@modifies *p_buf@*/ ;
 
-  if (exprNode_isError (e))
+static void 
+unparseBuffer_appendLength (unparseBuffer *buf, /*@null@*/ const char *s, size_t len)
+{
+  if (len == 0 || s == NULL)
     {
-      static /*@only@*/ cstring error = cstring_undefined;
+      return;
+    }
+
+  if (buf->len + len + 1 > buf->size)
+    {
+      size_t newsize = (buf->size == 0) ? UNPARSEBUFFERBASESIZE : buf->size;
 
-      if (!cstring_isDefined (error))
+      while (buf->len + len + 1 > newsize)
 	{
-	  error = cstring_makeLiteral ("<error>");
+	  newsize *= 2;
 	}
-      
-      return error;
+
+      buf->chars = (char *) drealloc (buf->chars, newsize * sizeof (*buf->chars));
+      buf->size = newsize;
+    }
+
+  llassert (buf->chars != NULL);
+  memcpy (buf->chars + buf->len, s, len);
+  buf->len += len;
+  buf->chars[buf->len] = '\0';
+}
+
+static void 
+unparseBuffer_append (unparseBuffer *buf, cstring s)
+{
+  unparseBuffer_appendLength (buf, cstring_toCharsSafe (s), cstring_length (s));
+}
+
+# define unparseBuffer_appendLit(buf,s) \
+  (unparseBuffer_appendLength (buf, s, sizeof (s) - 1))
+
+static void 
+unparseBuffer_appendFree (unparseBuffer *buf, /*@only@*/ cstring s)
+{
+  unparseBuffer_append (buf, s);
+  cstring_free (s);
+}
+
+static void 
+exprNode_unparseAppend (unparseBuffer *buf, /*@temp@*/ exprNode e)
+{
+  exprData data;
+
+  if (exprNode_isError (e))
+    {
+      unparseBuffer_appendLit (buf, "<error>");
+      return;
+    }
+
+  if (cstring_isDefined (e->etext))
+    {
+      unparseBuffer_append (buf, e->etext);
+      return;
     }
 
   data = e->edata;
@@ -9525,272 +9687,303 @@ static /*@only@*/ cstring exprNode_doUnparse (exprNode e)
   switch (e->kind)
     {
     case XPR_PARENS: 
-      ret = message ("(%s)", exprNode_unparse (exprData_getUopNode (e->edata)));
+      unparseBuffer_appendLit (buf, "(");
+      exprNode_unparseAppend (buf, exprData_getUopNode (data));
+      unparseBuffer_appendLit (buf, ")");
       break;
     case XPR_ASSIGN:
-      ret = message ("%s %s %s",
-		     exprNode_unparse (exprData_getOpA (data)), 
-		     lltok_unparse (exprData_getOpTok (data)),
-		     exprNode_unparse (exprData_getOpB (data)));
+    case XPR_OP:
+      exprNode_unparseAppend (buf, exprData_getOpA (data));
+      unparseBuffer_appendLit (buf, " ");
+      unparseBuffer_append (buf, lltok_unparse (exprData_getOpTok (data)));
+      unparseBuffer_appendLit (buf, " ");
+      exprNode_unparseAppend (buf, exprData_getOpB (data));
       break;
     case XPR_CALL:
-      ret = message ("%s(%q)",
-		     exprNode_unparse (exprData_getFcn (data)), 
-		     exprNodeList_unparse (exprData_getArgs (data)));
+      exprNode_unparseAppend (buf, exprData_getFcn (data));
+      unparseBuffer_appendLit (buf, "(");
+      exprNodeList_unparseAppend (buf, exprData_getArgs (data));
+      unparseBuffer_appendLit (buf, ")");
       break;
     case XPR_INITBLOCK:
-      ret = message ("{ %q }", exprNodeList_unparse (exprData_getArgs (data)));
+      unparseBuffer_appendLit (buf, "{ ");
+      exprNodeList_unparseAppend (buf, exprData_getArgs (data));
+      unparseBuffer_appendLit (buf, " }");
       break;
     case XPR_EMPTY:
-      ret = cstring_undefined;
       break;
     case XPR_LABEL:
-      ret = message ("%s:", exprData_getId (data));
+      unparseBuffer_append (buf, exprData_getId (data));
+      unparseBuffer_appendLit (buf, ":");
       break;
     case XPR_CONST:
     case XPR_VAR:
-      ret = cstring_copy (exprData_getId (data));
+      unparseBuffer_append (buf, exprData_getId (data));
       break;
     case XPR_FETCH:
-      ret = message ("%s[%s]", exprNode_unparse (exprData_getPairA (data)),
-		     exprNode_unparse (exprData_getPairB (data)));
+      exprNode_unparseAppend (buf, exprData_getPairA (data));
+      unparseBuffer_appendLit (buf, "[");
+      exprNode_unparseAppend (buf, exprData_getPairB (data));
+      unparseBuffer_appendLit (buf, "]");
       break;
     case XPR_BODY:
-      ret = message ("<body>");
+      unparseBuffer_appendLit (buf, "<body>");
       break;
-    case XPR_OP:
-      ret = message ("%s %s %s",
-		     exprNode_unparse (exprData_getOpA (data)), 
-		     lltok_unparse (exprData_getOpTok (data)),
-      		     exprNode_unparse (exprData_getOpB (data))); 
-      break;
-      
     case XPR_PREOP: 
-      ret = message ("%s%s",
-		     lltok_unparse (exprData_getUopTok (data)),
-		     exprNode_unparse (exprData_getUopNode (data))); 
+      unparseBuffer_append (buf, lltok_unparse (exprData_getUopTok (data)));
+      exprNode_unparseAppend (buf, exprData_getUopNode (data));
       break;
-
     case XPR_POSTOP:
-      ret = message ("%s%s",
-		     exprNode_unparse (exprData_getUopNode (data)),
-		     lltok_unparse (exprData_getUopTok (data))); 
+      exprNode_unparseAppend (buf, exprData_getUopNode (data));
+      unparseBuffer_append (buf, lltok_unparse (exprData_getUopTok (data)));
       break;
-      
     case XPR_OFFSETOF:
-      ret = message ("offsetof(%s,%q)", 
-		     ctype_unparse (qtype_getType (exprData_getOffsetType (data))),
-		     cstringList_unparseSep (exprData_getOffsetName (data), cstring_makeLiteralTemp (".")));
+      unparseBuffer_appendLit (buf, "offsetof(");
+      unparseBuffer_append (buf, ctype_unparse (qtype_getType (exprData_getOffsetType (data))));
+      unparseBuffer_appendLit (buf, ",");
+      unparseBuffer_appendFree (buf, cstringList_unparseSep (exprData_getOffsetName (data), 
+							     cstring_makeLiteralTemp (".")));
+      unparseBuffer_appendLit (buf, ")");
       break;
-
     case XPR_SIZEOFT:
-      ret = message ("sizeof(%s)", ctype_unparse (qtype_getType (exprData_getType (data))));
+      unparseBuffer_appendLit (buf, "sizeof(");
+      unparseBuffer_append (buf, ctype_unparse (qtype_getType (exprData_getType (data))));
+      unparseBuffer_appendLit (buf, ")");
       break;
-      
     case XPR_SIZEOF:
-      ret = message ("sizeof(%s)", exprNode_unparse (exprData_getSingle (data)));
+      unparseBuffer_appendLit (buf, "sizeof(");
+      exprNode_unparseAppend (buf, exprData_getSingle (data));
+      unparseBuffer_appendLit (buf, ")");
       break;
-
     case XPR_ALIGNOFT:
-      ret = message ("alignof(%s)", ctype_unparse (qtype_getType (exprData_getType (data))));
+      unparseBuffer_appendLit (buf, "alignof(");
+      unparseBuffer_append (buf, ctype_unparse (qtype_getType (exprData_getType (data))));
+      unparseBuffer_appendLit (buf, ")");
       break;
-      
     case XPR_ALIGNOF:
-      ret = message ("alignof(%s)", exprNode_unparse (exprData_getSingle (data)));
+      unparseBuffer_appendLit (buf, "alignof(");
+      exprNode_unparseAppend (buf, exprData_getSingle (data));
+      unparseBuffer_appendLit (buf, ")");
       break;
-      
     case XPR_VAARG:
-      ret = message ("va_arg(%s, %q)", 
-		     exprNode_unparse (exprData_getCastNode (data)),
-		     qtype_unparse (exprData_getCastType (data)));
+      unparseBuffer_appendLit (buf, "va_arg(");
+      exprNode_unparseAppend (buf, exprData_getCastNode (data));
+      unparseBuffer_appendLit (buf, ", ");
+      unparseBuffer_appendFree (buf, qtype_unparse (exprData_getCastType (data)));
+      unparseBuffer_appendLit (buf, ")");
       break;
-      
     case XPR_ITERCALL:
-      ret = message ("%q(%q)", 
-		     uentry_getName (exprData_getIterCallIter (data)),
-		     exprNodeList_unparse (exprData_getIterCallArgs (data)));
+      unparseBuffer_appendFree (buf, uentry_getName (exprData_getIterCallIter (data)));
+      unparseBuffer_appendLit (buf, "(");
+      exprNodeList_unparseAppend (buf, exprData_getIterCallArgs (data));
+      unparseBuffer_appendLit (buf, ")");
       break;
     case XPR_ITER:
-      ret = message ("%q(%q) %s %q",
-		     uentry_getName (exprData_getIterSname (data)),
-		     exprNodeList_unparse (exprData_getIterAlist (data)),
-		     exprNode_unparse (exprData_getIterBody (data)),
-		     uentry_getName (exprData_getIterEname (data)));
+      unparseBuffer_appendFree (buf, uentry_getName (exprData_getIterSname (data)));
+      unparseBuffer_appendLit (buf, "(");
+      exprNodeList_unparseAppend (buf, exprData_getIterAlist (data));
+      unparseBuffer_appendLit (buf, ") ");
+      exprNode_unparseAppend (buf, exprData_getIterBody (data));
+      unparseBuffer_appendLit (buf, " ");
+      unparseBuffer_appendFree (buf, uentry_getName (exprData_getIterEname (data)));
       break;
     case XPR_CAST:
-      ret = message ("(%q)%s", 
-		     qtype_unparse (exprData_getCastType (data)),
-		     exprNode_unparse (exprData_getCastNode (data)));
+      unparseBuffer_appendLit (buf, "(");
+      unparseBuffer_appendFree (buf, qtype_unparse (exprData_getCastType (data)));
+      unparseBuffer_appendLit (buf, ")");
+      exprNode_unparseAppend (buf, exprData_getCastNode (data));
       break;
-      
     case XPR_FOR:
-      ret = message ("%s %s", 
-		     exprNode_unparse (exprData_getPairA (data)), 
-		     exprNode_unparse (exprData_getPairB (data)));
+      exprNode_unparseAppend (buf, exprData_getPairA (data));
+      unparseBuffer_appendLit (buf, " ");
+      exprNode_unparseAppend (buf, exprData_getPairB (data));
       break;
-
     case XPR_FORPRED:
-            ret = message ("for (%s; %s; %s)",
-		     exprNode_unparse (exprData_getTripleInit (data)),
-		     exprNode_unparse (exprData_getTripleTest (data)),
-		     exprNode_unparse (exprData_getTripleInc (data)));
+      unparseBuffer_appendLit (buf, "for (");
+      exprNode_unparseAppend (buf, exprData_getTripleInit (data));
+      unparseBuffer_appendLit (buf, "; ");
+      exprNode_unparseAppend (buf, exprData_getTripleTest (data));
+      unparseBuffer_appendLit (buf, "; ");
+      exprNode_unparseAppend (buf, exprData_getTripleInc (data));
+      unparseBuffer_appendLit (buf, ")");
       break;
-      
     case XPR_GOTO:
-      ret = message ("goto %s", exprData_getLiteral (data));
+      unparseBuffer_appendLit (buf, "goto ");
+      unparseBuffer_append (buf, exprData_getLiteral (data));
       break;
-
     case XPR_CONTINUE:
-      ret = cstring_makeLiteral ("continue");
+      unparseBuffer_appendLit (buf, "continue");
       break;
-
     case XPR_BREAK:
-      ret = cstring_makeLiteral ("break");
+      unparseBuffer_appendLit (buf, "break");
       break;
-
     case XPR_RETURN:
-      ret = message ("return %s", exprNode_unparse (exprData_getSingle (data)));
+      unparseBuffer_appendLit (buf, "return ");
+      exprNode_unparseAppend (buf, exprData_getSingle (data));
       break;
-
     case XPR_NULLRETURN:
-      ret = cstring_makeLiteral ("return");
+      unparseBuffer_appendLit (buf, "return");
       break;
-
     case XPR_COMMA:
-      ret = message ("%s, %s", 
-		     exprNode_unparse (exprData_getPairA (data)),
-		     exprNode_unparse (exprData_getPairB (data)));
+      exprNode_unparseAppend (buf, exprData_getPairA (data));
+      unparseBuffer_appendLit (buf, ", ");
+      exprNode_unparseAppend (buf, exprData_getPairB (data));
       break;
-      
     case XPR_COND:
-      ret = message ("%s ? %s : %s",
-		     exprNode_unparse (exprData_getTriplePred (data)),
-		     exprNode_unparse (exprData_getTripleTrue (data)),
-		     exprNode_unparse (exprData_getTripleFalse (data)));
+      exprNode_unparseAppend (buf, exprData_getTriplePred (data));
+      unparseBuffer_appendLit (buf, " ? ");
+      exprNode_unparseAppend (buf, exprData_getTripleTrue (data));
+      unparseBuffer_appendLit (buf, " : ");
+      exprNode_unparseAppend (buf, exprData_getTripleFalse (data));
       break;
     case XPR_IF:
-      ret = message ("if (%s) %s", 
-		     exprNode_unparse (exprData_getPairA (data)),
-		     exprNode_unparse (exprData_getPairB (data)));
+      unparseBuffer_appendLit (buf, "if (");
+      exprNode_unparseAppend (buf, exprData_getPairA (data));
+      unparseBuffer_appendLit (buf, ") ");
+      exprNode_unparseAppend (buf, exprData_getPairB (data));
       break;
-      
     case XPR_IFELSE:
-      ret = message ("if (%s) %s else %s",
-		     exprNode_unparse (exprData_getTriplePred (data)),
-		     exprNode_unparse (exprData_getTripleTrue (data)),
-		     exprNode_unparse (exprData_getTripleFalse (data)));
+      unparseBuffer_appendLit (buf, "if (");
+      exprNode_unparseAppend (buf, exprData_getTriplePred (data));
+      unparseBuffer_appendLit (buf, ") ");
+      exprNode_unparseAppend (buf, exprData_getTripleTrue (data));
+      unparseBuffer_appendLit (buf, " else ");
+      exprNode_unparseAppend (buf, exprData_getTripleFalse (data));
       break;
     case XPR_WHILE:
-      ret = message ("while (%s) %s",
-		     exprNode_unparse (exprData_getPairA (data)),
-		     exprNode_unparse (exprData_getPairB (data)));
+      unparseBuffer_appendLit (buf, "while (");
+      exprNode_unparseAppend (buf, exprData_getPairA (data));
+      unparseBuffer_appendLit (buf, ") ");
+      exprNode_unparseAppend (buf, exprData_getPairB (data));
       break;
-
     case XPR_WHILEPRED:
-      ret = cstring_copy (exprNode_unparse (exprData_getSingle (data)));
+      exprNode_unparseAppend (buf, exprData_getSingle (data));
       break;
-
     case XPR_TOK:
-      ret = cstring_copy (lltok_unparse (exprData_getTok (data)));
+      unparseBuffer_append (buf, lltok_unparse (exprData_getTok (data)));
       break;
-
     case XPR_DOWHILE:
-      ret = message ("do { %s } while (%s)",
-		     exprNode_unparse (exprData_getPairB (data)),
-		     exprNode_unparse (exprData_getPairA (data)));
+      unparseBuffer_appendLit (buf, "do { ");
+      exprNode_unparseAppend (buf, exprData_getPairB (data));
+      unparseBuffer_appendLit (buf, " } while (");
+      exprNode_unparseAppend (buf, exprData_getPairA (data));
+      unparseBuffer_appendLit (buf, ")");
       break;
-      
     case XPR_BLOCK:
-      ret = message ("{ %s }", exprNode_unparse (exprData_getSingle (data)));
+      unparseBuffer_appendLit (buf, "{ ");
+      exprNode_unparseAppend (buf, exprData_getSingle (data));
+      unparseBuffer_appendLit (buf, " }");
       /* evans 2002-02-20 was unparseFirst! */
       break;
-
     case XPR_STMT:
-      ret = message ("%s;", exprNode_unparse (exprData_getUopNode (data)));
+      exprNode_unparseAppend (buf, exprData_getUopNode (data));
+      unparseBuffer_appendLit (buf, ";");
       break;
-
     case XPR_STMTLIST:
+      exprNode_unparseAppend (buf, exprData_getPairA (data));
+
       if (exprNode_isStatement (exprData_getPairA (data)))
 	{
 	  /*
 	  ** statement expressions already print the ;
 	  */
 
-	  ret = message ("%s %s", 
-			 exprNode_unparse (exprData_getPairA (data)),
-			 exprNode_unparse (exprData_getPairB (data)));
+	  unparseBuffer_appendLit (buf, " ");
 	}
       else
 	{
-	  ret = message ("%s; %s", 
-			 exprNode_unparse (exprData_getPairA (data)),
-			 exprNode_unparse (exprData_getPairB (data)));
+	  unparseBuffer_appendLit (buf, "; ");
 	}
+
+      exprNode_unparseAppend (buf, exprData_getPairB (data));
       break;
-      
     case XPR_FTDEFAULT:
     case XPR_DEFAULT:
-      ret = cstring_makeLiteral ("default:");
+      unparseBuffer_appendLit (buf, "default:");
       break;
-
     case XPR_SWITCH:
-      ret = message ("switch (%s) %s", 
-		     exprNode_unparse (exprData_getPairA (data)),
-		     exprNode_unparse (exprData_getPairB (data)));
+      unparseBuffer_appendLit (buf, "switch (");
+      exprNode_unparseAppend (buf, exprData_getPairA (data));
+      unparseBuffer_appendLit (buf, ") ");
+      exprNode_unparseAppend (buf, exprData_getPairB (data));
       break;
-
     case XPR_FTCASE:
     case XPR_CASE:
-      ret = message ("case %s:", 
-		     exprNode_unparse (exprData_getSingle (data)));
+      unparseBuffer_appendLit (buf, "case ");
+      exprNode_unparseAppend (buf, exprData_getSingle (data));
+      unparseBuffer_appendLit (buf, ":");
       break;
-      
     case XPR_INIT:
-      if (exprNode_isError (exprData_getInitNode (data)))
-	{
-	  ret = message ("%q", idDecl_unparseC (exprData_getInitId (data)));
-	}
-      else
+      unparseBuffer_appendFree (buf, idDecl_unparseC (exprData_getInitId (data)));
+
+      if (!exprNode_isError (exprData_getInitNode (data)))
 	{
-	  ret = message ("%q = %s",
-			 idDecl_unparseC (exprData_getInitId (data)),
-			 exprNode_unparse (exprData_getInitNode (data)));
+	  unparseBuffer_appendLit (buf, " = ");
+	  exprNode_unparseAppend (buf, exprData_getInitNode (data));
 	}
       break;
-      
     case XPR_FACCESS:
-      ret = message ("%s.%s",
-		     exprNode_unparse (exprData_getFieldNode (data)),
-		     exprData_getFieldName (data));
+      exprNode_unparseAppend (buf, exprData_getFieldNode (data));
+      unparseBuffer_appendLit (buf, ".");
+      unparseBuffer_append (buf, exprData_getFieldName (data));
       break;
-      
     case XPR_ARROW:
-            ret = message ("%s->%s",
-		     exprNode_unparse (exprData_getFieldNode (data)),
-		     exprData_getFieldName (data));
+      exprNode_unparseAppend (buf, exprData_getFieldNode (data));
+      unparseBuffer_appendLit (buf, "->");
+      unparseBuffer_append (buf, exprData_getFieldName (data));
       break;
-
     case XPR_STRINGLITERAL:
       if (ctype_isWideString (e->typ))
 	{
-	  ret = message ("L\"%s\"", exprData_getLiteral (data));
+	  unparseBuffer_appendLit (buf, "L");
 	}
-      else
-	{
-	  ret = message ("\"%s\"", exprData_getLiteral (data));
-	}
-      break;
 
+      unparseBuffer_appendLit (buf, "\"");
+      unparseBuffer_append (buf, exprData_getLiteral (data));
+      unparseBuffer_appendLit (buf, "\"");
+      break;
     case XPR_NUMLIT:
-      ret = cstring_copy (exprData_getLiteral (data));
+      unparseBuffer_append (buf, exprData_getLiteral (data));
       break;
-
     case XPR_NODE:
-      ret = cstring_makeLiteral ("<node>");
+      unparseBuffer_appendLit (buf, "<node>");
       break;
     }
+}
 
-  return ret;
+static void 
+exprNodeList_unparseAppend (unparseBuffer *buf, exprNodeList s)
+{
+  bool first = TRUE;
+
+  exprNodeList_elements (s, el)
+    {
+      if (!first)
+	{
+	  unparseBuffer_appendLit (buf, ", ");
+	}
+
+      exprNode_unparseAppend (buf, el);
+      first = FALSE;
+    } end_exprNodeList_elements;
+}
+
+static /*@only@*/ cstring exprNode_doUnparse (exprNode e)
+{
+  unparseBuffer buf;
+
+  buf.chars = NULL;
+  buf.len = 0;
+  buf.size = 0;
+
+  exprNode_unparseAppend (&buf, e);
+
+  if (buf.chars == NULL)
+    {
+      return cstring_undefined;
+    }
+
+  return cstring_fromChars (buf.chars);
 }
 
 bool
@@ -754,11 +754,32 @@ fileTable_getNameBase (fileTable ft, fileId fid)
   return (ft->elements[fid]->basename);
 }
 
+/*
+** Returns the id fileTable_sameBase compares for fid: the file fid is
+** derived from, if there is one.
+*/
+
+fileId
+fileTable_baseId (fileTable ft, fileId fid)
+{
+  fileId fder;
+
+  llassert (fileTable_isDefined (ft) && fileId_isValid (fid));
+  fder = ft->elements[fid]->fder;
+
+  if (fileId_isValid (fder))
+    {
+      return fder;
+    }
+  else
+    {
+      return fid;
+    }
+}
+
 bool
 fileTable_sameBase (fileTable ft, fileId f1, fileId f2)
 {
-  fileId fd1, fd2;
-
   if (!fileId_isValid (f1))
     {
       return FALSE;
@@ -776,22 +797,7 @@ fileTable_sameBase (fileTable ft, fileId f1, fileId f2)
       return TRUE;
     }
 
-  fd1 = ft->elements[f1]->fder;
-
-  if (!fileId_isValid (fd1))
-    {
-      fd1 = f1;
-    }
-
-  fd2 = ft->elements[f2]->fder;
-
-
-  if (!fileId_isValid (fd2))
-    {
-      fd2 = f2;
-    }
-
-  return (fd1 == fd2);
+  return (fileTable_baseId (ft, f1) == fileTable_baseId (ft, f2));
 }
 
 void
@@ -36,6 +36,12 @@
 
 static int flagMarkerList_lastBeforeLoc (flagMarkerList p_s, fileloc p_loc) /*@*/ ;
 
+static void flagMarkerList_noteInsert (flagMarkerList p_s, int p_index) 
+   /*@modifies p_s@*/ ;
+
+static void flagMarkerList_hashInsert (flagMarkerList p_s, /*@dependent@*/ flagMarker p_fm) 
+   /*@modifies p_s@*/ ;
+
 static bool
 flagMarkerList_contains (flagMarkerList p_s, flagMarker p_fm) /*@*/ ;
 
@@ -49,6 +55,12 @@ flagMarkerList
   s->elements = (flagMarker *)
     dmalloc (sizeof (*s->elements) * flagMarkerListBASESIZE);
 
+  s->nfiles = 0;
+  s->files = NULL;
+
+  s->hashsize = 0;
+  s->hashed = NULL;
+
   return (s);
 }
 
@@ -58,7 +70,7 @@ flagMarkerList_grow (flagMarkerList s)
   int i;
   flagMarker *newelements;
   
-  s->nspace += flagMarkerListBASESIZE; 
+  s->nspace += s->nelements + flagMarkerListBASESIZE; 
 
   newelements = (flagMarker *) dmalloc (sizeof (*newelements) 
 					* (s->nelements + s->nspace));
@@ -217,6 +229,7 @@ bool flagMarkerList_add (flagMarkerList s, flagMarker fm)
     }
 
   s->nelements++;
+  flagMarkerList_noteInsert (s, lastloc == -1 ? s->nelements - 1 : lastloc + 1);
   return TRUE;
 }
 
@@ -305,6 +318,7 @@ static void flagMarkerList_splice (flagMarkerList s,
   s->nelements++;
   s->nspace--;
 
+  flagMarkerList_noteInsert (s, index + 1);
   }
 
 /*@only@*/ cstring
@@ -336,27 +350,252 @@ flagMarkerList_free (flagMarkerList s)
       flagMarker_free (s->elements[i]);
     }
   
+  for (i = 0; i < s->nfiles; i++)
+    {
+      llassert (s->files != NULL);
+      sfree (s->files[i].byloc);
+      sfree (s->files[i].maxindex);
+    }
+
   sfree (s->elements); 
+  sfree (s->files);
+  sfree (s->hashed);
   sfree (s);
 }
 
 static int
-flagMarkerList_lastBeforeLoc (flagMarkerList s, fileloc loc)
+flagMarker_hashIndex (flagMarker fm, int size)
+{
+  fileloc loc = flagMarker_getLoc (fm);
+  unsigned int h = 0;
+
+  if (fileloc_isDefined (loc))
+    {
+      h = (unsigned int) fileloc_lineno (loc) * 31u + (unsigned int) fileloc_column (loc);
+    }
+
+  return (int) (h % (unsigned int) size);
+}
+
+/*
+** Equal flagMarkers have locations on the same line and column, so
+** they hash to the same chain.
+*/
+
+static void
+flagMarkerList_hashInsert (flagMarkerList s, flagMarker fm)
 {
   int i;
 
-  for (i = s->nelements - 1; i >= 0; i--) 
+  if (2 * (s->nelements + 1) > s->hashsize)
     {
-      flagMarker current = s->elements[i];
-      
-      if (fileloc_sameFile (current->loc, loc) 
-	  && (!flagMarker_beforeMarker (current, loc)))
+      flagMarker *oldhashed = s->hashed;
+      int oldsize = s->hashsize;
+
+      s->hashsize = (oldsize == 0) ? flagMarkerListHASHBASESIZE : 2 * oldsize;
+      s->hashed = (flagMarker *) dmalloc (sizeof (*s->hashed) * s->hashsize);
+
+      for (i = 0; i < s->hashsize; i++)
+	{
+	  s->hashed[i] = NULL;
+	}
+
+      for (i = 0; i < oldsize; i++)
+	{
+	  llassert (oldhashed != NULL);
+
+	  if (oldhashed[i] != NULL)
+	    {
+	      flagMarkerList_hashInsert (s, oldhashed[i]);
+	    }
+	}
+
+      sfree (oldhashed);
+    }
+
+  llassert (s->hashed != NULL);
+
+  for (i = flagMarker_hashIndex (fm, s->hashsize); 
+       s->hashed[i] != NULL; 
+       i = (i + 1) % s->hashsize)
+    {
+      ;
+    }
+
+  s->hashed[i] = fm;
+}
+
+/*
+** Returns the index of the elements in the file of loc, or NULL if
+** there is none (and create is FALSE).
+*/
+
+static /*@null@*/ /*@exposed@*/ flagMarkerFileIndex *
+flagMarkerList_fileIndex (flagMarkerList s, fileloc loc, bool create)
+{
+  int fid;
+
+  if (fileloc_isUndefined (loc) || fileloc_isLib (loc)
+      || !fileId_isValid (fileloc_fileId (loc)))
+    {
+      return NULL; /* not fileloc_sameFile as anything */
+    }
+
+  fid = fileTable_baseId (context_fileTable (), fileloc_fileId (loc));
+
+  if (fid >= s->nfiles)
+    {
+      int i;
+
+      if (!create)
+	{
+	  return NULL;
+	}
+
+      s->files = (flagMarkerFileIndex *) 
+	drealloc (s->files, sizeof (*s->files) * (fid + 1));
+
+      for (i = s->nfiles; i <= fid; i++)
 	{
-	  return i;
+	  s->files[i].n = 0;
+	  s->files[i].space = 0;
+	  s->files[i].byloc = NULL;
+	  s->files[i].maxindex = NULL;
 	}
+
+      s->nfiles = fid + 1;
     }
 
-  return -1;
+  llassert (s->files != NULL);
+  return &s->files[fid];
+}
+
+/*
+** Returns the number of elements in fi that are not after loc.  They
+** come first, since fi is sorted by location.
+*/
+
+static int
+flagMarkerList_countNotAfter (flagMarkerList s, flagMarkerFileIndex *fi, fileloc loc)
+{
+  int low = 0;
+  int high = fi->n;
+
+  while (low < high)
+    {
+      int mid = (low + high) / 2;
+
+      llassert (fi->byloc != NULL);
+
+      if (flagMarker_beforeMarker (s->elements[fi->byloc[mid]], loc))
+	{
+	  high = mid;
+	}
+      else
+	{
+	  low = mid + 1;
+	}
+    }
+
+  return low;
+}
+
+/*
+** Element index was just inserted: shift the indexes of the elements
+** after it, and add it to the index of its file.
+*/
+
+static void
+flagMarkerList_noteInsert (flagMarkerList s, int index)
+{
+  fileloc loc = flagMarker_getLoc (s->elements[index]);
+  flagMarkerFileIndex *fi;
+  int i, j;
+
+  flagMarkerList_hashInsert (s, s->elements[index]);
+
+  if (index < s->nelements - 1)
+    {
+      for (i = 0; i < s->nfiles; i++)
+	{
+	  llassert (s->files != NULL);
+	  fi = &s->files[i];
+
+	  for (j = 0; j < fi->n; j++)
+	    {
+	      llassert (fi->byloc != NULL && fi->maxindex != NULL);
+
+	      if (fi->byloc[j] >= index) 
+		{
+		  fi->byloc[j]++;
+		}
+
+	      if (fi->maxindex[j] >= index) 
+		{
+		  fi->maxindex[j]++;
+		}
+	    }
+	}
+    }
+
+  fi = flagMarkerList_fileIndex (s, loc, TRUE);
+
+  if (fi == NULL)
+    {
+      return;
+    }
+
+  if (fi->n >= fi->space)
+    {
+      fi->space = 2 * fi->space + flagMarkerListBASESIZE;
+      fi->byloc = (int *) drealloc (fi->byloc, sizeof (*fi->byloc) * fi->space);
+      fi->maxindex = (int *) drealloc (fi->maxindex, sizeof (*fi->maxindex) * fi->space);
+    }
+
+  llassert (fi->byloc != NULL && fi->maxindex != NULL);
+
+  i = flagMarkerList_countNotAfter (s, fi, loc);
+
+  for (j = fi->n; j > i; j--)
+    {
+      fi->byloc[j] = fi->byloc[j - 1];
+    }
+
+  fi->byloc[i] = index;
+  fi->n++;
+
+  for (j = i; j < fi->n; j++)
+    {
+      fi->maxindex[j] = (j == 0 || fi->byloc[j] > fi->maxindex[j - 1]) 
+	? fi->byloc[j] : fi->maxindex[j - 1];
+    }
+}
+
+/*
+** Returns the index of the last element in the same file as loc that
+** is not after loc, or -1.
+*/
+
+static int
+flagMarkerList_lastBeforeLoc (flagMarkerList s, fileloc loc)
+{
+  flagMarkerFileIndex *fi = flagMarkerList_fileIndex (s, loc, FALSE);
+  int count;
+
+  if (fi == NULL)
+    {
+      return -1;
+    }
+
+  count = flagMarkerList_countNotAfter (s, fi, loc);
+
+  if (count == 0)
+    {
+      return -1;
+    }
+
+  llassert (fi->maxindex != NULL);
+  return fi->maxindex[count - 1];
 }
 
 static bool
@@ -364,11 +603,16 @@ flagMarkerList_contains (flagMarkerList s, flagMarker fm)
 {
   int i;
 
-  for (i = s->nelements - 1; i >= 0; i--) 
+  if (s->hashed == NULL)
     {
-      flagMarker current = s->elements[i];
-      
-      if (flagMarker_equal (current, fm))
+      return FALSE;
+    }
+
+  for (i = flagMarker_hashIndex (fm, s->hashsize); 
+       s->hashed[i] != NULL; 
+       i = (i + 1) % s->hashsize)
+    {
+      if (flagMarker_equal (s->hashed[i], fm))
 	{
 	  return TRUE;
 	}
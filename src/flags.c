@@ -1310,6 +1310,7 @@ void flags_setValueFlag (flagcode opt, cstring arg)
     case FLG_NUMSTRUCTFIELDS:
     case FLG_NUMENUMMEMBERS:
     case FLG_INCLUDENEST:
+    case FLG_HISTORYLIMIT:
       {
 	int val = cstring_toPosInt (arg);
 
@@ -47,6 +47,7 @@ FILE *g_warningstream = NULL;
 FILE *g_messagestream = NULL;
 FILE *g_errorstream = NULL;
 FILE *g_csvstream = NULL;
+FILE *g_jsonstream = NULL;
 
 /*
 ** These were in llmain.c.  Most should not be globals...
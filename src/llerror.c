@@ -62,8 +62,12 @@ static bool llgenerroraux (flagcode p_code, char *p_srcFile, int p_srcLine,
 			   fileloc p_fl, bool p_iserror, bool p_indent)
                  /*@modifies g_warningstream@*/ ;
 
+static void generateMachineOutput (flagcode p_code, cstring p_s, cstring p_addtext, fileloc p_fl) 
+     /*@modifies g_csvstream, g_jsonstream@*/ ;
 static void generateCSV (flagcode p_code, cstring p_s, cstring p_addtext, fileloc p_fl) 
      /*@modifies g_csvstream@*/ ;
+static void generateJSON (flagcode p_code, cstring p_s, cstring p_addtext, fileloc p_fl) 
+     /*@modifies g_jsonstream@*/ ;
 
 static void printError (FILE *p_stream, /*@only@*/ cstring p_sc)
    /*@globals s_lastfileloclen @*/
@@ -1069,12 +1073,30 @@ xllforceerror (char *srcFile, int srcLine,
   }
 }
 
+/*
+** Machine-readable output (+csv, +json) is written straight from the
+** unformatted message text, one record per line, without going through
+** the line splitting done for the text output.
+*/
+
+static void generateMachineOutput (flagcode code, cstring s, cstring addtext, fileloc fl)
+{
+  generateCSV (code, s, addtext, fl);
+  generateJSON (code, s, addtext, fl);
+}
+
 static void generateCSV (flagcode code, cstring s, cstring addtext, fileloc fl)
 {
 
   if (g_csvstream != NULL) {
+    if (context_getBatchJob () > 0)
+      {
+	/* the Job column is only present with -batch */
+	fprintf (g_csvstream, "%d,", context_getBatchJob ());
+      }
+
     /* Warning, Flag Code, Flag Name, Priority, File, Line, Column, Warning Text, Additional Text */
-    fprintf (g_csvstream, "%d,%d,%s,%d,%s,%d,%d,\"%s\"",
+    fprintf (g_csvstream, "%d,%d,%s,%d,%s,%d,%d,\"%s\"%s%s%s\n",
 	     context_numErrors (),
 	     (int) code, /* flag code */
 	     cstring_toCharsSafe (flagcode_unparse (code)), /* flag name */
@@ -1082,14 +1104,142 @@ static void generateCSV (flagcode code, cstring s, cstring addtext, fileloc fl)
 	     cstring_toCharsSafe (fileloc_outputFilename (fl)),
 	     fileloc_lineno (fl),
 	     fileloc_column (fl),
-	     cstring_toCharsSafe (s));
+	     cstring_toCharsSafe (s),
+	     cstring_isDefined (addtext) ? ",\"" : "",
+	     cstring_toCharsSafe (addtext),
+	     cstring_isDefined (addtext) ? "\"" : "");
+  }
+}
 
-    if (cstring_isDefined (addtext)) {
-      fprintf (g_csvstream, ",\"%s\"\n", cstring_toCharsSafe (addtext));
-    } else {
-      fprintf (g_csvstream, "\n");
+/*
+** Returns the length of the well-formed UTF-8 sequence starting at c,
+** or 0 if there is none.
+*/
+
+static int utf8SequenceLength (char *c) /*@*/
+{
+  unsigned char lead = (unsigned char) c[0];
+  unsigned char low = 0x80;
+  unsigned char high = 0xBF;
+  int len, i;
+
+  if (lead >= 0xC2 && lead <= 0xDF)
+    {
+      len = 2;
+    }
+  else if (lead >= 0xE0 && lead <= 0xEF)
+    {
+      len = 3;
+      if (lead == 0xE0) low = 0xA0;  /* overlong */
+      if (lead == 0xED) high = 0x9F; /* surrogates */
+    }
+  else if (lead >= 0xF0 && lead <= 0xF4)
+    {
+      len = 4;
+      if (lead == 0xF0) low = 0x90;
+      if (lead == 0xF4) high = 0x8F;
+    }
+  else
+    {
+      return 0;
+    }
+
+  for (i = 1; i < len; i++)
+    {
+      unsigned char next = (unsigned char) c[i];
+
+      if (next < low || next > high)
+	{
+	  return 0;
+	}
+
+      low = 0x80;
+      high = 0xBF;
+    }
+
+  return len;
+}
+
+/*
+** Writes s as a JSON string.  Bytes that are not part of a well-formed
+** UTF-8 sequence (e.g., Latin-1 source text) are written as the
+** corresponding \u00XX escape, so the output is always valid UTF-8.
+*/
+
+static void printJSONString (FILE *stream, cstring s)
+   /*@modifies *stream@*/
+{
+  char *c = cstring_toCharsSafe (s);
+
+  (void) putc ('"', stream);
+
+  for (; *c != '\0'; c++)
+    {
+      switch (*c)
+	{
+	case '"':  (void) fputs ("\\\"", stream); break;
+	case '\\': (void) fputs ("\\\\", stream); break;
+	case '\n': (void) fputs ("\\n", stream); break;
+	case '\t': (void) fputs ("\\t", stream); break;
+	case '\r': (void) fputs ("\\r", stream); break;
+	default:
+	  if ((unsigned char) *c < 0x20)
+	    {
+	      fprintf (stream, "\\u%04x", (unsigned) (unsigned char) *c);
+	    }
+	  else if ((unsigned char) *c < 0x80)
+	    {
+	      (void) putc (*c, stream);
+	    }
+	  else
+	    {
+	      int len = utf8SequenceLength (c);
+
+	      if (len == 0)
+		{
+		  fprintf (stream, "\\u%04x", (unsigned) (unsigned char) *c);
+		}
+	      else
+		{
+		  (void) fwrite (c, sizeof (*c), size_fromInt (len), stream);
+		  c += len - 1;
+		}
+	    }
+	}
+    }
+
+  (void) putc ('"', stream);
+}
+
+static void generateJSON (flagcode code, cstring s, cstring addtext, fileloc fl)
+{
+  if (g_jsonstream != NULL)
+    {
+      /* One JSON object per line (JSON Lines) */
+      (void) putc ('{', g_jsonstream);
+
+      if (context_getBatchJob () > 0)
+	{
+	  fprintf (g_jsonstream, "\"job\": %d, ", context_getBatchJob ());
+	}
+
+      fprintf (g_jsonstream, "\"warning\": %d, \"code\": %d, \"flag\": ",
+	       context_numErrors (), (int) code);
+      printJSONString (g_jsonstream, flagcode_unparse (code));
+      fprintf (g_jsonstream, ", \"priority\": %d, \"file\": ", flagcode_priority (code));
+      printJSONString (g_jsonstream, fileloc_outputFilename (fl));
+      fprintf (g_jsonstream, ", \"line\": %d, \"column\": %d, \"message\": ",
+	       fileloc_lineno (fl), fileloc_column (fl));
+      printJSONString (g_jsonstream, s);
+
+      if (cstring_isDefined (addtext))
+	{
+	  (void) fputs (", \"hint\": ", g_jsonstream);
+	  printJSONString (g_jsonstream, addtext);
+	}
+
+      (void) fputs ("}\n", g_jsonstream);
     }
-  }
 }
 
 static bool
@@ -1256,7 +1406,7 @@ llgenerrorreal (flagcode code, char *srcFile, int srcLine,
   flstring = fileloc_unparse (fl);
   s_lastfileloclen = cstring_length (flstring);
 
-  generateCSV (code, s, addtext, fl);
+  generateMachineOutput (code, s, addtext, fl);
 
   if (indent)
     {
@@ -1737,7 +1887,7 @@ void genppllerrorhint (flagcode code, /*@only@*/ cstring s,
     {
       if (context_getFlag (code))
 	{
-	  generateCSV (code, s, hint, g_currentloc);
+	  generateMachineOutput (code, s, hint, g_currentloc);
 	  prepareMessage ();
 	  context_clearPreprocessing ();
 	  llerror (code, s);
@@ -96,6 +96,15 @@ static fileIdList preprocessFiles (fileIdList, bool)
 
 static void warnSysFiles(fileIdList p_files) /*@modifies fileSystem@*/;
 
+static void runBatchJobs (cstring p_batchfile, fileIdList p_xfiles, fileIdList p_cfiles,
+			  cstringList *p_passThroughArgs)
+  /*@modifies fileSystem, internalState, p_xfiles, p_cfiles, *p_passThroughArgs@*/ ;
+static void checkBatchStream (flagcode p_flag, /*@only@*/ cstring p_oldval)
+  /*@modifies internalState@*/ ;
+static /*@null@*/ /*@dependent@*/ FILE *
+  openWarningsFile (flagcode p_fileflag, flagcode p_overwriteflag, /*@observer@*/ char *p_kind)
+  /*@modifies fileSystem@*/ ;
+
 static
 void lslCleanup (void)
    /*@globals killed g_symtab@*/
@@ -672,28 +681,16 @@ int main (int argc, char *argv[])
 
   showHerald (); 
 
-  if (context_getFlag (FLG_CSV)) {
-    cstring fname = context_getString (FLG_CSV);
+  g_csvstream = openWarningsFile (FLG_CSV, FLG_CSVOVERWRITE, "CSV");
 
-    if (cstring_isDefined (fname)) {
-      if (osd_fileExists (fname) && !context_getFlag (FLG_CSVOVERWRITE)) {
-	lldiagmsg (message ("Specified CSV output file already exists (use +csvoverwrite to automatically overwrite): %s",
-			    fname));
-      } else {
-	g_csvstream = fopen (cstring_toCharsSafe (fname), "w");
-	
-	DPRINTF (("Creating: %s", fname));
-	if (g_csvstream == NULL) {
-	  lldiagmsg (message ("Cannot open file for CSV output: %s", fname));
-	} else {
-	  displayScan (message ("Starting CSV output file: %s", context_getString (FLG_CSV)));
-	  fprintf (g_csvstream, 
-		   "Warning, Flag Code, Flag Name, Priority, File, Line, Column, Warning Text, Additional Text\n");
-	}
-      }
-    }
+  if (g_csvstream != NULL) {
+    fprintf (g_csvstream, "%s%s",
+	     cstring_isNonEmpty (context_getString (FLG_BATCH)) ? "Job, " : "",
+	     "Warning, Flag Code, Flag Name, Priority, File, Line, Column, Warning Text, Additional Text\n");
   }
 
+  g_jsonstream = openWarningsFile (FLG_JSON, FLG_JSONOVERWRITE, "JSON");
+
 # ifdef DOANNOTS
   initAnnots ();
 # endif
@@ -765,6 +762,12 @@ int main (int argc, char *argv[])
   */
 
   context_setInCommandLine ();
+
+  if (cstring_isNonEmpty (context_getString (FLG_BATCH)))
+    {
+      /* Only batch jobs return. */
+      runBatchJobs (context_getString (FLG_BATCH), xfiles, cfiles, &passThroughArgs);
+    }
   
   DPRINTF (("Pass through: %s", cstringSList_unparse (passThroughArgs)));
   
@@ -880,6 +883,11 @@ int main (int argc, char *argv[])
 	  context_enterFile ();
 	  (void) yyparse ();
 	  context_exitCFile ();
+
+	  if (context_getFlag (FLG_COMPACTFILES))
+	    {
+	      context_compactFile (fileTable_baseId (context_fileTable (), fid));
+	    }
 		    
 	  (void) inputStream_close (sourceFile);
 	}      
@@ -956,6 +964,11 @@ int main (int argc, char *argv[])
     displayScan (message ("Closing CSV file: %s", context_getString (FLG_CSV)));
     check (fclose (g_csvstream) == 0);
   }
+
+  if (g_jsonstream != NULL) {
+    displayScan (message ("Closing JSON file: %s", context_getString (FLG_JSON)));
+    check (fclose (g_jsonstream) == 0);
+  }
   
   if (context_getFlag (FLG_SHOWSUMMARY))
     {
@@ -1307,6 +1320,7 @@ llexit (int status)
       cppReader_destroyMod ();
       sRef_destroyMod ();
       uentry_destroyMod ();
+      useIndex_destroyMod ();
       typeIdSet_destroyMod ();
       qual_destroyMod ();
       osd_destroyMod ();
@@ -1319,6 +1333,155 @@ llexit (int status)
   exit ((status == LLSUCCESS) ? EXIT_SUCCESS : EXIT_FAILURE);
 }
 
+/*
+** The warning streams are opened before the batch jobs start, so a job
+** cannot redirect them.  Reports a job that sets flag, and restores its
+** old value so the stream is closed under the right name.
+*/
+
+static void checkBatchStream (flagcode flag, /*@only@*/ cstring oldval)
+{
+  if (!cstring_equal (context_getString (flag), oldval))
+    {
+      voptgenerror 
+	(FLG_BADFLAG,
+	 message ("Flag %s in a batch job is ignored (set it on the command line)",
+		  flagcode_unparse (flag)),
+	 g_currentloc);
+
+      context_setString (flag, oldval);
+    }
+  else
+    {
+      cstring_free (oldval);
+    }
+}
+
+/*
+** Runs each job in the batch file in a child process that continues
+** from the current state, after adding the job's flags and files.
+** Returns only in the children.  The parent exits when all jobs are
+** done, with failure status if any job failed.
+*/
+
+static void runBatchJobs (cstring batchfile, fileIdList xfiles, fileIdList cfiles,
+			  cstringList *passThroughArgs)
+{
+  FILE *f = fileTable_openReadFile (context_fileTable (), batchfile);
+  cstringList *jobs;
+  cstringList args;
+  int njobs = 0;
+  int jobspace = SMALLBASESIZE;
+  bool failed = FALSE;
+  int i;
+
+  if (f == NULL)
+    {
+      llfatalerror (message ("Cannot open batch file: %s", batchfile));
+    }
+
+  /*
+  ** Read all the jobs first, since children share the file offset.
+  */
+
+  jobs = (cstringList *) dmalloc (sizeof (*jobs) * jobspace);
+
+  while (rcfiles_readJob (f, &args))
+    {
+      if (njobs == jobspace)
+	{
+	  cstringList *newjobs;
+
+	  jobspace *= 2;
+	  newjobs = (cstringList *) dmalloc (sizeof (*newjobs) * jobspace);
+
+	  for (i = 0; i < njobs; i++)
+	    {
+	      newjobs[i] = jobs[i];
+	    }
+
+	  sfree (jobs);
+	  jobs = newjobs;
+	}
+
+      jobs[njobs] = args;
+      njobs++;
+    }
+
+  check (fileTable_closeFile (context_fileTable (), f));
+
+  for (i = 0; i < njobs; i++)
+    {
+      int status;
+
+      /*
+      ** The jobs all write to the same streams, so each one's output
+      ** is headed by its job number (which the CSV and JSON records
+      ** also carry).
+      */
+
+      if (!context_getFlag (FLG_QUIET))
+	{
+	  llmsg (message ("Batch job %d: %q", i + 1,
+			  cstringList_unparseSep (jobs[i], 
+						  cstring_makeLiteralTemp (" "))));
+	}
+
+      if (osd_runInChild (&status))
+	{
+	  fileIdList lclfiles = fileIdList_create ();
+	  fileIdList mtfiles = fileIdList_create ();
+	  cstring csvfile = cstring_copy (context_getString (FLG_CSV));
+	  cstring jsonfile = cstring_copy (context_getString (FLG_JSON));
+
+	  context_setBatchJob (i + 1);
+
+	  flags_processFlags (TRUE, xfiles, cfiles, lclfiles, mtfiles,
+			      passThroughArgs,
+			      cstringList_size (jobs[i]),
+			      /*@-nullstate@*/ /*@-type@*/ /* exposes cstring type */ 
+			      cstringList_getElements (jobs[i])
+			      /*@=nullstate@*/ /*@=type@*/
+			      );
+
+	  if (!fileIdList_isEmpty (lclfiles) || !fileIdList_isEmpty (mtfiles))
+	    {
+	      voptgenerror 
+		(FLG_BADFLAG,
+		 cstring_makeLiteral ("Specification and metastate files in a batch job "
+				      "are ignored (list them on the command line)"),
+		 g_currentloc);
+	    }
+
+	  checkBatchStream (FLG_CSV, csvfile);
+	  checkBatchStream (FLG_JSON, jsonfile);
+
+	  fileIdList_free (lclfiles);
+	  fileIdList_free (mtfiles);
+	  return;
+	}
+      
+      if (status != LLSUCCESS)
+	{
+	  if (status < 0)
+	    {
+	      llmsg (message ("Batch job %d did not complete: %q", i + 1,
+			      cstringList_unparse (jobs[i])));
+	    }
+
+	  failed = TRUE;
+	}
+    }
+
+  for (i = 0; i < njobs; i++)
+    {
+      cstringList_free (jobs[i]);
+    }
+
+  sfree (jobs);
+  llexit (failed ? LLFAILURE : LLSUCCESS);
+}
+
 static fileIdList preprocessFiles (fileIdList fl, bool xhfiles)
   /*@modifies fileSystem@*/
 {
@@ -1465,3 +1628,47 @@ void warnSysFiles(fileIdList files)
     } 
   end_fileIdList_elements;
 }
+
+/*
+** Opens the machine-readable warnings file named by fileflag (e.g.,
+** +csv).  These files can get very large, so they are given a large
+** stdio buffer instead of the default one.
+*/
+
+# define WARNINGSFILEBUFSIZE (256 * 1024)
+
+static /*@null@*/ /*@dependent@*/ FILE *
+openWarningsFile (flagcode fileflag, flagcode overwriteflag, char *kind)
+{
+  cstring fname;
+  FILE *res;
+
+  if (!context_getFlag (fileflag)) {
+    return NULL;
+  }
+
+  fname = context_getString (fileflag);
+
+  if (!cstring_isDefined (fname)) {
+    return NULL;
+  }
+
+  if (osd_fileExists (fname) && !context_getFlag (overwriteflag)) {
+    lldiagmsg (message ("Specified %s output file already exists (use +%s to automatically overwrite): %s",
+			cstring_fromChars (kind), flagcode_unparse (overwriteflag), fname));
+    return NULL;
+  }
+
+  res = fopen (cstring_toCharsSafe (fname), "w");
+  
+  DPRINTF (("Creating: %s", fname));
+
+  if (res == NULL) {
+    lldiagmsg (message ("Cannot open file for %s output: %s", cstring_fromChars (kind), fname));
+  } else {
+    (void) setvbuf (res, NULL, _IOFBF, WARNINGSFILEBUFSIZE);
+    displayScan (message ("Starting %s output file: %s", cstring_fromChars (kind), fname));
+  }
+
+  return res;
+}
@@ -136,7 +136,13 @@ macrocache_addGenEntry (macrocache s, /*@only@*/ fileloc fl,
 
   if ((i = macrocache_exists (s, fl)) != DNE)
     {
-        if (cstring_equal (def, s->contents[i]->def))
+      /*
+      ** Once a macro has been checked its definition is no longer
+      ** needed (and may have been discarded by macrocache_compact).
+      */
+
+      if (s->contents[i]->defined 
+	  || cstring_equal (def, s->contents[i]->def))
 	{
 	  fileloc_free (fl);
 	  cstring_free (def);
@@ -401,6 +407,50 @@ extern /*@observer@*/ fileloc macrocache_processFileElements (macrocache m, cstr
   return lastfl;
 }
 
+/*
+** Called after file fid has been checked.  Definitions of macros that
+** have been checked are freed, and macros in fid itself (which cannot
+** be seen again) are removed.  Entries for checked macros in other
+** files are kept so later includes do not check them again.  Returns
+** the number of definitions freed.
+*/
+
+int macrocache_compact (macrocache s, fileId fid)
+{
+  int i, j = 0;
+  int nfreed = 0;
+
+  for (i = 0; i < s->entries; i++)
+    {
+      mce m = s->contents[i];
+
+      if (m->defined && cstring_isDefined (m->def))
+	{
+	  nfreed++;
+	}
+
+      if (m->defined && fileId_equal (fileloc_fileId (m->fl), fid))
+	{
+	  mce_free (m);
+	}
+      else
+	{
+	  if (m->defined)
+	    {
+	      cstring_free (m->def);
+	      m->def = cstring_undefined;
+	    }
+
+	  s->contents[j] = m;
+	  j++;
+	}
+    }
+
+  s->nspace += s->entries - j;
+  s->entries = j;
+  return nfreed;
+}
+
 void macrocache_finalize (void)
 {
   if (s_macFile != NULL)
@@ -35,12 +35,12 @@
 # include "basic.h"
 
 /*@constant int MAPPING_SIZE; @*/
-# define MAPPING_SIZE 127
+# define MAPPING_SIZE 128
 
 /* use lower-order bits by masking out higher order bits */
 
 /*@-macrofcndecl@*/
-# define MMASH(key)  ((unsigned int) ((key) & MAPPING_SIZE))
+# define MMASH(t, key)  ((unsigned int) (key) & ((t)->size - 1))
 /*@=macrofcndecl@*/
 
 static void mappair_free (/*@null@*/ /*@only@*/ mappair *p)
@@ -60,7 +60,7 @@ void mapping_free (/*@only@*/ mapping m)
 {
   int i;
 
-  for (i = 0; i <= MAPPING_SIZE; i++)
+  for (i = 0; i < (int) m->size; i++)
     {
       mappair_free (m->buckets[i]);
     }
@@ -75,10 +75,11 @@ mapping_create (void)
   int i;
   mapping t = (mapping) dmalloc (sizeof (*t));
 
-  t->buckets = (mappair **) dmalloc ((MAPPING_SIZE + 1) * sizeof (*t->buckets));
+  t->buckets = (mappair **) dmalloc (MAPPING_SIZE * sizeof (*t->buckets));
   t->count = 0;
+  t->size = MAPPING_SIZE;
 
-  for (i = 0; i <= MAPPING_SIZE; i++)
+  for (i = 0; i < MAPPING_SIZE; i++)
     {
       t->buckets[i] = (mappair *) 0;
     }
@@ -86,13 +87,59 @@ mapping_create (void)
   return t;
 }
 
+/*
+** Doubles the number of buckets.  Each chain splits into two chains
+** (masking in one more bit), keeping the order of its entries.
+*/
+
+static void
+mapping_grow (mapping t)
+{
+  unsigned int i;
+  unsigned int oldsize = t->size;
+  mappair **oldbuckets = t->buckets;
+
+  t->size = oldsize * 2;
+  t->buckets = (mappair **) dmalloc (t->size * sizeof (*t->buckets));
+
+  for (i = 0; i < oldsize; i++)
+    {
+      mappair **low = &t->buckets[i];
+      mappair **high = &t->buckets[i + oldsize];
+      mappair *entry = oldbuckets[i];
+
+      while (entry != NULL)
+	{
+	  mappair *next = entry->next;
+
+	  if (MMASH (t, entry->domain) == i)
+	    {
+	      *low = entry;
+	      low = &entry->next;
+	    }
+	  else
+	    {
+	      *high = entry;
+	      high = &entry->next;
+	    }
+
+	  entry = next;
+	}
+
+      *low = NULL;
+      *high = NULL;
+    }
+
+  sfree (oldbuckets);
+}
+
 lsymbol
 mapping_find (mapping t, lsymbol domain)
 {
   mappair *entry;
   unsigned int key;
 
-  key = MMASH (domain);
+  key = MMASH (t, domain);
   entry = t->buckets[key];
   for (; entry != NULL; entry = entry->next)
     {
@@ -113,7 +160,12 @@ mapping_bind (mapping t, lsymbol domain, lsymbol range)
   mappair *newentry = (mappair *) dmalloc (sizeof (*newentry));
   unsigned int key;
 
-  key = MMASH (domain);
+  if (t->count >= 2 * t->size)
+    {
+      mapping_grow (t);
+    }
+
+  key = MMASH (t, domain);
   /*@-deparrays@*/ entry = t->buckets[key]; /*@=deparrays@*/
   newentry->domain = domain;
   newentry->range = range;
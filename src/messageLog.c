@@ -180,6 +180,40 @@ bool messageLog_add (messageLog s, fileloc fl, cstring mess)
   return TRUE;
 }
 
+/*
+** Removes the messages located in file fid.  Used once a file has been
+** checked and its locations cannot be reported again.  Returns the
+** number of messages removed.
+*/
+
+int messageLog_removeFile (messageLog s, fileId fid)
+{
+  int i, j = 0;
+  int nremoved;
+
+  llassert (messageLog_isDefined (s));
+
+  for (i = 0; i < s->nelements; i++)
+    {
+      msgentry msg = s->elements[i];
+
+      if (fileId_equal (fileloc_fileId (msg->loc), fid))
+	{
+	  msgentry_free (msg);
+	}
+      else
+	{
+	  s->elements[j] = msg;
+	  j++;
+	}
+    }
+
+  nremoved = s->nelements - j;
+  s->nspace += nremoved;
+  s->nelements = j;
+  return nremoved;
+}
+
 /*@only@*/ cstring
 messageLog_unparse (messageLog s)
 {
@@ -40,6 +40,7 @@ metaStateInfo_create (cstring name,
   int i;
 
   res->name = name;
+  res->id = -1;
   res->valueNames = valueNames;
   res->context = context;
 
@@ -129,6 +130,13 @@ metaStateInfo_getMergeTable (metaStateInfo info) /*@*/
   return info->mergetable;
 }
 
+void metaStateInfo_setId (metaStateInfo info, int id)
+{
+  llassert (metaStateInfo_isDefined (info));
+  llassert (id >= 0);
+  info->id = id;
+}
+
 /*@+enumindex@*/ /* allow context kinds to reference array */
 extern int metaStateInfo_getDefaultValueContext (metaStateInfo info, mtContextKind context)
 {
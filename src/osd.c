@@ -55,6 +55,7 @@
 # define getcwd _getcwd
 # else
 # include <unistd.h>
+# include <sys/wait.h>
 # endif
 
 /*@end@*/
@@ -522,6 +523,44 @@ osd_getPid ()
   return pid;
 }
   
+/*
+** Returns TRUE in a new copy of this process.  In this process,
+** waits for the copy to exit and returns FALSE, with *status set
+** to its exit status (or -1 if it could not be run or did not
+** exit normally).
+*/
+
+bool osd_runInChild (int *status)
+{
+# if defined (WIN32) || defined (OS2)
+  *status = -1;
+  return FALSE;
+# else
+  pid_t pid;
+  int wstatus;
+
+  (void) fflush (NULL);
+  pid = fork ();
+
+  if (pid == 0)
+    {
+      *status = 0;
+      return TRUE;
+    }
+
+  if (pid < 0 || waitpid (pid, &wstatus, 0) != pid || !WIFEXITED (wstatus))
+    {
+      *status = -1;
+    }
+  else
+    {
+      *status = WEXITSTATUS (wstatus);
+    }
+
+  return FALSE;
+# endif
+}
+
 cstring osd_fixDefine (cstring x)
 {
   /*@access cstring@*/
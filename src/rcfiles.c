@@ -80,109 +80,116 @@ bool rcfiles_read (cstring fname, cstringList *passThroughArgs, bool report)
   return res;
 }
 
-static void rcfiles_loadFile (/*:open:*/ FILE *rcfile, cstringList *passThroughArgs)
-   /*@modifies rcfile@*/
-   /*@ensures closed rcfile@*/
+/*
+** Adds the flags on the line s to args.  Quoted flags may contain spaces.
+*/
+
+static /*@only@*/ cstringList rcfiles_splitLine (char *s, /*@only@*/ cstringList args)
+   /*@modifies s@*/
 {
-  char *s = mstring_create (MAX_LINE_LENGTH);
   char *os = s;
-  cstringList args = cstringList_new ();
-
-  DPRINTF (("Loading rc file..."));
-  
-  s = os;
+  char c;
 
-  while (reader_readLine (rcfile, s, MAX_LINE_LENGTH) != NULL)
+  while (*s == ' ' || *s == '\t')
     {
-      char c;
-
-      DPRINTF (("Line: %s", s));
-      DPRINTF (("args: %s", cstringList_unparse (args)));
+      s++;
+      incColumn ();
+    }
+      
+  while (*s != '\0')
+    {
+      char *thisflag;
+      bool escaped = FALSE;
+      bool quoted = FALSE;
+      c = *s;
 
-      while (*s == ' ' || *s == '\t')
+      /* comment characters */
+      if (c == '#' || c == ';' || c == '\n') 
 	{
-	  s++;
-	  incColumn ();
+	  /*@innerbreak@*/
+	  break;
 	}
-      
-      while (*s != '\0')
-	{
-	  char *thisflag;
-	  bool escaped = FALSE;
-	  bool quoted = FALSE;
-	  c = *s;
-
-	  /* comment characters */
-	  if (c == '#' || c == ';' || c == '\n') 
-	    {
-	      /*@innerbreak@*/
-	      break;
-	    }
 	  
-	  thisflag = s;
+      thisflag = s;
 	  
-	  while ((c = *s) != '\0')
-	    { /* remember to handle spaces and quotes in -D and -U ... */
-	      if (escaped)
-		{
-		  escaped = FALSE;
-		}
-	      else if (quoted)
+      while ((c = *s) != '\0')
+	{ /* remember to handle spaces and quotes in -D and -U ... */
+	  if (escaped)
+	    {
+	      escaped = FALSE;
+	    }
+	  else if (quoted)
+	    {
+	      if (c == '\\')
 		{
-		  if (c == '\\')
-		    {
-		      escaped = TRUE;
-		    }
-		  else if (c == '\"')
-		    {
-		      quoted = FALSE;
-		    }
-		  else
-		    {
-		      ;
-		    }
+		  escaped = TRUE;
 		}
 	      else if (c == '\"')
 		{
-		  quoted = TRUE;
+		  quoted = FALSE;
 		}
 	      else
 		{
-		 if (c == ' ' || c == '\t' || c == '\n')
-		   {
-		     /*@innerbreak@*/ break;
-		   }
-	       }
-		  
-	      s++; 
-	      incColumn ();
+		  ;
+		}
 	    }
-
-	  DPRINTF (("Nulling: %c", *s));
-	  *s = '\0';
-
-	  if (mstring_isEmpty (thisflag))
+	  else if (c == '\"')
 	    {
-	      llfatalerror (message ("Missing flag: %s",
-				     cstring_fromChars (os)));
+	      quoted = TRUE;
 	    }
 	  else
 	    {
-	      args = cstringList_add (args, cstring_fromCharsNew (thisflag));
-	      DPRINTF (("args: %s", cstringList_unparse (args)));
+	      if (c == ' ' || c == '\t' || c == '\n')
+		{
+		  /*@innerbreak@*/ break;
+		}
 	    }
+		  
+	  s++; 
+	  incColumn ();
+	}
+
+      DPRINTF (("Nulling: %c", *s));
+      *s = '\0';
+
+      if (mstring_isEmpty (thisflag))
+	{
+	  llfatalerror (message ("Missing flag: %s",
+				 cstring_fromChars (os)));
+	}
+      else
+	{
+	  args = cstringList_add (args, cstring_fromCharsNew (thisflag));
+	  DPRINTF (("args: %s", cstringList_unparse (args)));
+	}
 	  
-	  *s = c;
-	  DPRINTF (("Pass through: %s", cstringList_unparse (*passThroughArgs)));
+      *s = c;
 	  
-	  while ((c == ' ') || (c == '\t'))
-	    {
-	      c = *(++s);
-	      incColumn ();
-	    } 
-	}
-      
-      s = os;
+      while ((c == ' ') || (c == '\t'))
+	{
+	  c = *(++s);
+	  incColumn ();
+	} 
+    }
+
+  return args;
+}
+
+static void rcfiles_loadFile (/*:open:*/ FILE *rcfile, cstringList *passThroughArgs)
+   /*@modifies rcfile@*/
+   /*@ensures closed rcfile@*/
+{
+  char *s = mstring_create (MAX_LINE_LENGTH);
+  char *os = s;
+  cstringList args = cstringList_new ();
+
+  DPRINTF (("Loading rc file..."));
+  
+  while (reader_readLine (rcfile, s, MAX_LINE_LENGTH) != NULL)
+    {
+      DPRINTF (("Line: %s", s));
+      DPRINTF (("args: %s", cstringList_unparse (args)));
+      args = rcfiles_splitLine (s, args);
     }
 
   sfree (os); 
@@ -205,3 +212,32 @@ static void rcfiles_loadFile (/*:open:*/ FILE *rcfile, cstringList *passThroughA
 
 
 
+
+/*
+** Reads the flags and files on the next non-empty line of a batch file
+** into *args.  Returns FALSE (and sets *args to undefined) at the end
+** of the file.
+*/
+
+bool rcfiles_readJob (FILE *f, cstringList *args)
+{
+  char *s = mstring_create (MAX_LINE_LENGTH);
+
+  *args = cstringList_new ();
+
+  while (reader_readLine (f, s, MAX_LINE_LENGTH) != NULL)
+    {
+      *args = rcfiles_splitLine (s, *args);
+
+      if (cstringList_size (*args) > 0)
+	{
+	  sfree (s);
+	  return TRUE;
+	}
+    }
+
+  sfree (s);
+  cstringList_free (*args);
+  *args = cstringList_undefined;
+  return FALSE;
+}
@@ -274,6 +274,13 @@ static nrefers = 0;
 
 static /*@checked@*/ bool protectDerivs = FALSE;
 
+/*
+** Cached shapes (see sRef_shape) are valid only in the epoch they
+** were computed in.  The epoch changes whenever a cached shape changes.
+*/
+
+static int s_shapeEpoch = 0;
+
 /*
 ** Result of sRef_alloc is dependent since allRefs may
 ** reference it.  It is only if !inFunction.
@@ -285,6 +292,8 @@ sRef_alloc (void)
   sRef s = (sRef) dmalloc (sizeof (*s));
 
   s->immut = FALSE;
+  s->shape = 0;
+  s->shapeepoch = -1;
 
   DPRINTF (("Alloc sref: [%p]", s));
 
@@ -1639,6 +1648,127 @@ static bool cref_equal (cref c1, cref c2)
 	  (usymId_equal (c1->index, c2->index)));
 }
 
+/*
+** The shape of an sRef built only from variables, parameters, fields,
+** array fetches, pointers and addresses is a hash of its kind and info,
+** including its base.  Other sRefs have shape 0.  Array indexes are not
+** included, and array fetches and pointers hash the same, so sRefs that
+** any of same, realSame, similar or similarRelaxed consider equal have
+** the same shape.  The shapes are cached, so two sRefs with different
+** shapes can be told apart without walking their bases.
+*/
+
+static unsigned int sRef_shape (sRef p_s) /*@modifies p_s@*/ ;
+
+static unsigned int shape_mix (unsigned int h, unsigned int x) /*@*/
+{
+  h = (h * 31u) + x;
+  return (h == 0) ? 1u : h;
+}
+
+static unsigned int sRef_computeShape (/*@notnull@*/ sRef s)
+   /*@modifies s@*/
+{
+  unsigned int base;
+
+  switch (s->kind)
+    {
+    case SK_CVAR:
+      return shape_mix (shape_mix ((unsigned int) SK_CVAR,
+				   (unsigned int) s->info->cvar->lexlevel),
+			(unsigned int) usymId_toInt (s->info->cvar->index));
+    case SK_PARAM:
+      return shape_mix ((unsigned int) SK_PARAM,
+			(unsigned int) s->info->paramno);
+    case SK_ARRAYFETCH:
+      base = sRef_shape (s->info->arrayfetch->arr);
+      return (base == 0) ? 0 : shape_mix (base, (unsigned int) SK_PTR);
+    case SK_PTR:
+    case SK_ADR:
+      base = sRef_shape (s->info->ref);
+      return (base == 0) ? 0 : shape_mix (base, (unsigned int) s->kind);
+    case SK_FIELD:
+      base = sRef_shape (s->info->field->rec);
+
+      if (base == 0)
+	{
+	  return 0;
+	}
+      else
+	{
+	  const char *p = cstring_toCharsSafe (s->info->field->field);
+
+	  base = shape_mix (base, (unsigned int) SK_FIELD);
+
+	  while (*p != '\0')
+	    {
+	      base = shape_mix (base, (unsigned int) *p);
+	      p++;
+	    }
+
+	  return base;
+	}
+    default:
+      return 0;
+    }
+}
+
+static unsigned int sRef_shape (sRef s)
+{
+  if (!sRef_isReasonable (s))
+    {
+      return 0;
+    }
+
+  if (s->shapeepoch != s_shapeEpoch)
+    {
+      s->shape = sRef_computeShape (s);
+      s->shapeepoch = s_shapeEpoch;
+    }
+
+  return s->shape;
+}
+
+/*
+** Must be called after the kind or info of s changes.  Cached shapes
+** built on s are only stale if the shape of s changed.
+*/
+
+static void sRef_updateShape (/*@notnull@*/ sRef s)
+   /*@globals s_shapeEpoch@*/ /*@modifies s, s_shapeEpoch@*/
+{
+  if (s->shapeepoch == s_shapeEpoch)
+    {
+      unsigned int oshape = s->shape;
+
+      s->shapeepoch = -1;
+
+      if (sRef_shape (s) != oshape)
+	{
+	  s_shapeEpoch++;
+	}
+    }
+}
+
+/*
+** True if s1 and s2 both have shapes, and they are different.
+*/
+
+static bool sRef_differentShapes (sRef s1, sRef s2)
+{
+  unsigned int shape1 = sRef_shape (s1);
+
+  if (shape1 == 0)
+    {
+      return FALSE;
+    }
+  else
+    {
+      unsigned int shape2 = sRef_shape (s2);
+      return (shape2 != 0 && shape2 != shape1);
+    }
+}
+
 /*
 ** returns true if s1 could be the same storage as s2.
 ** i.e., a[?] ~ a[3].  Note its not symmetric ... s1
@@ -1673,6 +1803,7 @@ sRef_similarRelaxedAux (sRef s1, sRef s2)
     }
 
   if (sRef_isInvalid (s1) || sRef_isInvalid (s2)) return FALSE;
+  if (sRef_differentShapes (s1, s2)) return FALSE;
 
   if (sRef_isConj (s2)) 
     return (sRef_similarRelaxedAux (s1, sRef_getConjA (s2)) ||
@@ -1808,6 +1939,7 @@ sRef_similar (sRef s1, sRef s2)
 {
   if (s1 == s2) return TRUE;
   if (sRef_isInvalid (s1) || sRef_isInvalid (s2)) return FALSE;
+  if (sRef_differentShapes (s1, s2)) return FALSE;
 
   if (sRef_isConj (s2)) 
     {
@@ -2041,6 +2173,8 @@ sRef_realSame (sRef s1, sRef s2)
       return FALSE;
     }
 
+  if (sRef_differentShapes (s1, s2)) return FALSE;
+
   switch (s1->kind)
     {
     case SK_CVAR:
@@ -2117,6 +2251,7 @@ sRef_same (sRef s1, sRef s2)
 {
   if (s1 == s2) return TRUE;
   if (sRef_isInvalid (s1) || sRef_isInvalid (s2)) return FALSE;
+  if (sRef_differentShapes (s1, s2)) return FALSE;
 
   switch (s1->kind)
     {
@@ -3277,6 +3412,7 @@ sRef_setParamNo (sRef s, int l)
   llassert (sRef_isReasonable (s) && s->kind == SK_PARAM);
   s->info->paramno = l;
   llassert (l >= -1);
+  sRef_updateShape (s);
 }
 
 /*@dependent@*/ sRef
@@ -3694,6 +3830,7 @@ sRef_mergeStateQuietReverse (/*@dependent@*/ sRef res, /*@dependent@*/ sRef othe
       sinfo_update (res, other);
     }
 
+  sRef_updateShape (res);
   res->modified = res->modified || other->modified;
   res->safe = res->safe && other->safe;
 
@@ -4050,9 +4187,9 @@ sRef_mergeStateAux (/*@notnull@*/ sRef res, /*@notnull@*/ sRef other,
   ** This doesn't do anything.  And its broken too...
   */
 
-  valueTable_elements (res->state, key, sv) 
+  valueTable_elements (res->state, id, key, sv) 
     {
-      stateValue os = valueTable_lookup (other->state, key);
+      stateValue os = valueTable_lookupId (other->state, id);
       /*@unused@*/ int val;
       /*@unused@*/ char *msg;
 
@@ -6434,6 +6571,7 @@ void sRef_setArrayFetchState (/*@notnull@*/ /*@exposed@*/ sRef s,
       if (sRef_isArrayFetch (t))
 	{
 	  s->info->arrayfetch->arr = t->info->arrayfetch->arr;
+	  sRef_updateShape (s);
 	}
     }
   else if (ctype_isRealPointer (arr->type))
@@ -7787,9 +7925,9 @@ sRef_showRefKilled (sRef s)
     {
       DPRINTF (("Killed: %s", sRef_unparseFull (s)));
       if (context_getLocIndentSpaces () == 0) {
-	stateInfo_display (s->definfo, message ("  Storage %q", sRef_unparseOpt (s)));
+	stateInfo_display (&s->definfo, message ("  Storage %q", sRef_unparseOpt (s)));
       } else {
-	stateInfo_display (s->definfo, message ("Storage %q", sRef_unparseOpt (s)));
+	stateInfo_display (&s->definfo, message ("Storage %q", sRef_unparseOpt (s)));
       }
     }
 }
@@ -7811,9 +7949,9 @@ sRef_showStateInfo (sRef s)
 {
   if (sRef_isValid (s)) {
     if (context_getLocIndentSpaces () == 0) {
-      stateInfo_display (s->definfo, message ("   Storage %q", sRef_unparseOpt (s)));
+      stateInfo_display (&s->definfo, message ("   Storage %q", sRef_unparseOpt (s)));
     } else {
-      stateInfo_display (s->definfo, message ("Storage %q", sRef_unparseOpt (s)));
+      stateInfo_display (&s->definfo, message ("Storage %q", sRef_unparseOpt (s)));
     }
   }
 }
@@ -7823,9 +7961,9 @@ sRef_showExpInfo (sRef s)
 {
   if (sRef_isValid (s)) {
     if (context_getLocIndentSpaces () == 0) {
-      stateInfo_display (s->expinfo, message ("   Storage %q", sRef_unparseOpt (s)));
+      stateInfo_display (&s->expinfo, message ("   Storage %q", sRef_unparseOpt (s)));
     } else {
-      stateInfo_display (s->expinfo, message ("Storage %q", sRef_unparseOpt (s)));
+      stateInfo_display (&s->expinfo, message ("Storage %q", sRef_unparseOpt (s)));
     }
   }
 }
@@ -7929,17 +8067,17 @@ sRef_showAliasInfo (sRef s)
       if (sRef_isFresh (s))
 	{
 	  if (context_getLocIndentSpaces () == 0) {
-	    stateInfo_display (s->aliasinfo, message ("   Fresh storage %q", sRef_unparseOpt (s)));
+	    stateInfo_display (&s->aliasinfo, message ("   Fresh storage %q", sRef_unparseOpt (s)));
 	  } else {
-	    stateInfo_display (s->aliasinfo, message ("Fresh storage %q", sRef_unparseOpt (s)));
+	    stateInfo_display (&s->aliasinfo, message ("Fresh storage %q", sRef_unparseOpt (s)));
 	  }
 	}
       else
 	{
 	  if (context_getLocIndentSpaces () == 0) {
-	    stateInfo_display (s->aliasinfo, message ("   Storage %q", sRef_unparseOpt (s))); 
+	    stateInfo_display (&s->aliasinfo, message ("   Storage %q", sRef_unparseOpt (s))); 
 	  } else {
-	    stateInfo_display (s->aliasinfo, message ("Storage %q", sRef_unparseOpt (s)));
+	    stateInfo_display (&s->aliasinfo, message ("Storage %q", sRef_unparseOpt (s)));
 	  }
 	}
     }
@@ -9870,21 +10008,21 @@ void sRef_reflectAnnotation (sRef s, annotationInfo a, fileloc loc)
 {
   if (sRef_isReasonable (s))
     {
+      int id = metaStateInfo_getId (annotationInfo_getState (a));
+
       if (!valueTable_isDefined (s->state))
 	{
-	  s->state = valueTable_create (1);
-	  valueTable_insert
-	    (s->state, 
-	     cstring_copy (metaStateInfo_getName (annotationInfo_getState (a))),
+	  s->state = valueTable_create (context_numMetaStates ());
+	  valueTable_insertId
+	    (s->state, id,
 	     stateValue_create (annotationInfo_getValue (a), 
 				stateInfo_makeLoc (loc, SA_DECLARED)));
 	}
       else
 	{
 	  DPRINTF (("reflect loc: %s", fileloc_unparse (loc)));
-	  valueTable_update 
-	    (s->state,
-	     metaStateInfo_getName (annotationInfo_getState (a)),
+	  valueTable_updateId 
+	    (s->state, id,
 	     stateValue_create (annotationInfo_getValue (a),
 				stateInfo_makeLoc (loc, SA_DECLARED)));
 	  
@@ -9918,28 +10056,34 @@ void sRef_setMetaStateValue (sRef s, cstring key, int value, fileloc loc)
 
   if (sRef_isReasonable (s))
     {
+      metaStateInfo msinfo = context_lookupMetaStateInfo (key);
+      int id;
+
+      llassert (metaStateInfo_isDefined (msinfo));
+      id = metaStateInfo_getId (msinfo);
+
       if (!valueTable_isDefined (s->state))
 	{
 	  DPRINTF (("inserting state: %s: %s %d", sRef_unparse (s), key, value));
-	  s->state = valueTable_create (1);
-	  valueTable_insert (s->state, cstring_copy (key),
-			     stateValue_create (value, 
-						stateInfo_makeLoc (loc, SA_CHANGED)));
+	  s->state = valueTable_create (context_numMetaStates ());
+	  valueTable_insertId (s->state, id,
+			       stateValue_create (value, 
+						  stateInfo_makeLoc (loc, SA_CHANGED)));
 	}
       else
 	{
 	  DPRINTF (("Updating state: %s: %s %d / %s", sRef_unparse (s), key, value,
 		    fileloc_unparse (loc)));
-	  if (valueTable_contains (s->state, key))
+	  if (stateValue_isDefined (valueTable_lookupId (s->state, id)))
 	    {
-	      valueTable_update 
-		(s->state, key, stateValue_create (value,
-						   stateInfo_makeLoc (loc, SA_CHANGED)));
+	      valueTable_updateId 
+		(s->state, id, stateValue_create (value,
+						  stateInfo_makeLoc (loc, SA_CHANGED)));
 	    }
 	  else
 	    {
-	      valueTable_insert 
-		(s->state, cstring_copy (key),
+	      valueTable_insertId 
+		(s->state, id,
 		 stateValue_create (value, stateInfo_makeLoc (loc, SA_CHANGED)));
 	    }
 
@@ -58,12 +58,18 @@ static lsymbol newUnionTag (void) /*@*/ ;
 /*@constant static int HOFSORTHANDLE; @*/
 # define HOFSORTHANDLE 1
 
+/*@constant static sort NOSORTINDEX; @*/
+# define NOSORTINDEX ((sort) -1)
+
 /* local routines */
 
 static void sort_addTupleMembers (sort p_tupleSort, sort p_strSort)  
    /*@modifies internalState@*/ ;
 
 static bool sort_isNewEntry (sortNode p_s) /*@*/ ;  
+static sort sort_lookupKindName (sortKind p_kind, lsymbol p_name) /*@*/ ;
+static void sort_growTable (void) /*@modifies internalState@*/ ;
+static void sort_indexName (sort p_sor) /*@modifies internalState@*/ ;
 
 static sort sort_enterNew (/*@only@*/ sortNode p_s) 
    /*@modifies internalState@*/ ;
@@ -132,6 +138,17 @@ static /*@only@*/ /*@null@*/ o_sortNode *sortTable = (sortNode *) 0;
 static int sortTableSize = 0;
 static int sortTableAlloc = 0;
 
+/*
+** sortTable indexed by name: sortNameFirst[name] is the first sort
+** with that name, and sortNameNext[sor] the next one after sor (in
+** handle order), or NOSORTINDEX.  Lookups by name and by kind and
+** name walk these instead of the whole table.
+*/
+
+static /*@only@*/ /*@null@*/ sort *sortNameFirst = (sort *) 0;
+static size_t sortNameFirstAlloc = 0;
+static /*@only@*/ /*@null@*/ sort *sortNameNext = (sort *) 0;
+
 /* Important to keep sorts in some order because importing routines
 for sorts rely on this order to ensure that when we encounter a sort
 S1 that is based on sort S2, S2 is before S1 in the imported file. */
@@ -197,6 +214,8 @@ sort_destroyMod (void)
 	}
 
       sfree (sortTable);
+      sfree (sortNameFirst);
+      sfree (sortNameNext);
       /*@-branchstate@*/
     }
 } /*@=branchstate@*/
@@ -225,12 +244,14 @@ sort_makeHOFSort (sort base)
   outSort->mutable = FALSE;
   outSort->abstract = FALSE;
 
+  sort_growTable ();
   llassert (sortTable != NULL);
 
   outSort->handle = handle = sortTableSize;
   sortTable[handle] = outSort;
 
   sortTableSize++;
+  sort_indexName (handle);
   return handle;
 }
 
@@ -1937,8 +1958,6 @@ sort_init (void)
 sort
 sort_lookupName (lsymbol name)
 {
-  long int i;
-
   if (name == lsymbol_undefined)
     {
       return NOSORTHANDLE;
@@ -1946,32 +1965,123 @@ sort_lookupName (lsymbol name)
 
   llassert (sortTable != NULL);
 
-  for (i = 0; i < sortTableSize; i++)
+  if (sortNameFirst != NULL && name < sortNameFirstAlloc
+      && sortNameFirst[name] != NOSORTINDEX)
+    {
+      return sortNameFirst[name];
+    }
+
+  return NOSORTHANDLE;
+}
+
+/*
+** Returns the first sort with the given kind and name, or NOSORTINDEX.
+*/
+
+static sort
+sort_lookupKindName (sortKind kind, lsymbol name)
+{
+  sort sor;
+
+  if (sortNameFirst == NULL || name >= sortNameFirstAlloc)
+    {
+      return NOSORTINDEX;
+    }
+
+  llassert (sortTable != NULL);
+  llassert (sortNameNext != NULL);
+
+  for (sor = sortNameFirst[name]; sor != NOSORTINDEX; sor = sortNameNext[sor])
     {
-      if (sortTable[i]->name == name)
+      if (sortTable[sor]->kind == kind)
 	{
-	  return i;
+	  return sor;
 	}
     }
 
-  return NOSORTHANDLE;
+  return NOSORTINDEX;
 }
 
 static bool
 sort_isNewEntry (sortNode s)
 {
-  int i;
-  
-  for (i = 0; i < sortTableSize; i++)
+  return (sort_lookupKindName (s->kind, s->name) == NOSORTINDEX);
+}
+
+static void
+sort_growTable (void)
+{
+  if (sortTableSize >= sortTableAlloc)
     {
-      llassert (sortTable != NULL);
+      sortNode *oldSortTable = sortTable;
+      sort *oldSortNameNext = sortNameNext;
+      int i;
+
+      sortTableAlloc = (sortTableAlloc == 0) ? DELTA : 2 * sortTableAlloc;
+      sortTable = (sortNode *) dmalloc (sortTableAlloc * sizeof (*sortTable));
+      sortNameNext = (sort *) dmalloc (sortTableAlloc * sizeof (*sortNameNext));
+
+      if (sortTableSize > 0)
+	{
+	  llassert (oldSortTable != NULL);      
+	  llassert (oldSortNameNext != NULL);      
+
+	  for (i = 0; i < sortTableSize; i++)
+	    {
+	      sortTable[i] = oldSortTable[i];
+	      sortNameNext[i] = oldSortNameNext[i];
+	    }
+	}
+
+      sfree (oldSortTable);
+      sfree (oldSortNameNext);
+    }
+}
+
+/*
+** Adds the newest sort, sor, to the end of its name chain.
+*/
+
+static void
+sort_indexName (sort sor)
+{
+  lsymbol name;
+  sort *last;
+
+  llassert (sortTable != NULL);
+  llassert (sortNameNext != NULL);
 
-      if (sortTable[i]->kind == s->kind && sortTable[i]->name == s->name)
+  name = sortTable[sor]->name;
+
+  if (name >= sortNameFirstAlloc)
+    {
+      size_t newAlloc = (sortNameFirstAlloc == 0) ? (size_t) DELTA : sortNameFirstAlloc;
+      size_t i;
+
+      while (newAlloc <= name)
+	{
+	  newAlloc *= 2;
+	}
+
+      sortNameFirst = (sort *) drealloc (sortNameFirst, newAlloc * sizeof (*sortNameFirst));
+
+      for (i = sortNameFirstAlloc; i < newAlloc; i++)
 	{
-	  return FALSE;
+	  sortNameFirst[i] = NOSORTINDEX;
 	}
+
+      sortNameFirstAlloc = newAlloc;
+    }
+
+  llassert (sortNameFirst != NULL);
+
+  for (last = &sortNameFirst[name]; *last != NOSORTINDEX; last = &sortNameNext[*last])
+    {
+      ;
     }
-  return TRUE;
+
+  *last = sor;
+  sortNameNext[sor] = NOSORTINDEX;
 }
 
 static sort
@@ -1990,42 +2100,20 @@ sort_enterNew (sortNode s)
   ** operators for this sort. 
   */
 
-  long int i;
-  
-  for (i = 0; i < sortTableSize; i++)
-    {
-      llassert (sortTable != NULL);
-
-      if (sortTable[i]->kind == s->kind && sortTable[i]->name == s->name)
-	{
-	  sortNode_free (s);
-	  return i;
-	}
-    }
+  sort sor = sort_lookupKindName (s->kind, s->name);
 
-  if (sortTableSize >= sortTableAlloc)
+  if (sor != NOSORTINDEX)
     {
-      sortNode *oldSortTable = sortTable;
-
-      sortTableAlloc += DELTA;
-      sortTable = (sortNode *) dmalloc (sortTableAlloc * sizeof (*sortTable));
-
-      if (sortTableSize > 0)
-	{
-	  llassert (oldSortTable != NULL);      
-	  for (i = 0; i < sortTableSize; i++)
-	    {
-	      sortTable[i] = oldSortTable[i];
-	    }
-	}
-
-      sfree (oldSortTable);
+      sortNode_free (s);
+      return sor;
     }
 
+  sort_growTable ();
   llassert (sortTable != NULL);
 
   s->handle = sortTableSize;
   sortTable[sortTableSize++] = s;
+  sort_indexName (s->handle);
 
   /*@-compdef@*/ 
   return s->handle;
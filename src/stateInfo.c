@@ -35,14 +35,113 @@
 # endif
 
 static /*@observer@*/ cstring stateAction_unparse (stateAction p_sa) /*@*/ ;
+static /*@only@*/ /*@notnull@*/ stateInfo
+  stateInfo_push (/*@only@*/ /*@notnull@*/ stateInfo p_snew, /*@only@*/ stateInfo p_old);
+static void stateInfo_setDepths (stateInfo p_s) /*@modifies p_s@*/ ;
 
 void stateInfo_free (/*@only@*/ stateInfo a)
 {
-  if (a != NULL)
+  /*
+  ** Frees the entries no longer shared with any other history.
+  */
+
+  while (a != NULL)
     {
+      stateInfo prev;
+
+      llassert (a->refs > 0);
+      a->refs--;
+
+      if (a->refs > 0)
+	{
+	  break;
+	}
+
+      prev = a->previous;
       fileloc_free (a->loc);
       sfree (a);
+      a = prev;
+    }
+}
+
+/*
+** Returns a new history holding copies of the first n entries of s.
+*/
+
+static /*@only@*/ stateInfo stateInfo_prefix (stateInfo s, int n)
+{
+  stateInfo ret = stateInfo_undefined;
+  stateInfo last = stateInfo_undefined;
+  int i;
+
+  for (i = 0; i < n && stateInfo_isDefined (s); i++, s = s->previous)
+    {
+      stateInfo si = stateInfo_makeRefLoc (s->ref, s->loc, s->action);
+
+      if (last == NULL)
+	{
+	  ret = si;
+	}
+      else
+	{
+	  last->previous = si;
+	}
+
+      last = si;
     }
+
+  stateInfo_setDepths (ret);
+  return ret;
+}
+
+/*
+** Sets the depth of each entry in s (after s has been rearranged).
+*/
+
+static void stateInfo_setDepths (stateInfo s)
+{
+  int n = 0;
+  stateInfo si;
+
+  for (si = s; stateInfo_isDefined (si); si = si->previous)
+    {
+      n++;
+    }
+
+  for (si = s; stateInfo_isDefined (si); si = si->previous)
+    {
+      si->depth = n;
+      n--;
+    }
+}
+
+/*
+** Adds snew (a new single entry) in front of old, taking over the
+** reference to old.  If the history would exceed the historylimit
+** flag, only the most recent half of the limit is kept.
+*/
+
+static /*@only@*/ /*@notnull@*/ stateInfo
+stateInfo_push (/*@only@*/ /*@notnull@*/ stateInfo snew, /*@only@*/ stateInfo old)
+{
+  llassert (snew->previous == NULL);
+
+  if (old != NULL)
+    {
+      int limit = context_getValue (FLG_HISTORYLIMIT);
+
+      if (limit > 0 && old->depth >= limit)
+	{
+	  stateInfo trimmed = stateInfo_prefix (old, (limit - 1) / 2);
+
+	  stateInfo_free (old);
+	  old = trimmed;
+	}
+    }
+
+  snew->previous = old;
+  snew->depth = (old == NULL) ? 1 : old->depth + 1;
+  return snew;
 }
 
 /*@only@*/ stateInfo stateInfo_update (/*@only@*/ stateInfo old, stateInfo newinfo)
@@ -77,10 +176,9 @@ void stateInfo_free (/*@only@*/ stateInfo a)
 	}
       else
 	{
-	  stateInfo snew = stateInfo_makeRefLoc (newinfo->ref, 
-						 newinfo->loc, newinfo->action);
-	  llassert (snew->previous == NULL);
-	  snew->previous = old;
+	  stateInfo snew = stateInfo_push 
+	    (stateInfo_makeRefLoc (newinfo->ref, newinfo->loc, newinfo->action),
+	     old);
 	  DPRINTF (("Update state ==> %s", stateInfo_unparse (snew)));
 	  return snew;
 	}
@@ -165,9 +263,7 @@ stateInfo_updateLoc (/*@only@*/ stateInfo old, stateAction action, fileloc loc)
     }
   else
     {
-      stateInfo snew = stateInfo_makeLoc (loc, action);
-      llassert (snew->previous == NULL);
-      snew->previous = old;
+      stateInfo snew = stateInfo_push (stateInfo_makeLoc (loc, action), old);
       DPRINTF (("Update state ==> %s", stateInfo_unparse (snew)));
       return snew;
     }
@@ -194,9 +290,7 @@ stateInfo_updateRefLoc (/*@only@*/ stateInfo old, /*@exposed@*/ sRef ref,
     }
   else
     {
-      stateInfo snew = stateInfo_makeRefLoc (ref, loc, action);
-      llassert (snew->previous == NULL);
-      snew->previous = old;
+      stateInfo snew = stateInfo_push (stateInfo_makeRefLoc (ref, loc, action), old);
       DPRINTF (("Update state ==> %s", stateInfo_unparse (snew)));
       return snew;
     }
@@ -204,21 +298,18 @@ stateInfo_updateRefLoc (/*@only@*/ stateInfo old, /*@exposed@*/ sRef ref,
 
 /*@only@*/ stateInfo stateInfo_copy (stateInfo a)
 {
-  if (a == NULL)
+  /*
+  ** Histories are never modified, so the copy shares the entries.
+  */
+
+  if (a != NULL)
     {
-      return NULL;
+      a->refs++;
     }
-  else
-    {
-      stateInfo ret = (stateInfo) dmalloc (sizeof (*ret));
-      
-      ret->loc = fileloc_copy (a->loc); /*< should report bug without copy! >*/
-      ret->ref = a->ref;
-      ret->action = a->action;
-      ret->previous = stateInfo_copy (a->previous); 
 
-      return ret;
-    }
+  /*@-refcounttrans@*/ 
+  return a;
+  /*@=refcounttrans@*/
 }
 
 /*@only@*/ /*@notnull@*/ stateInfo
@@ -241,6 +332,8 @@ stateInfo_makeLoc (fileloc loc, stateAction action)
   ret->ref = sRef_undefined;
   ret->action = action;
   ret->previous = stateInfo_undefined;
+  ret->refs = 1;
+  ret->depth = 1;
 
   DPRINTF (("Make loc ==> %s", stateInfo_unparse (ret)));
   return ret;
@@ -261,6 +354,8 @@ stateInfo_makeRefLoc (/*@exposed@*/ sRef ref, fileloc loc, stateAction action)
   ret->ref = ref;
   ret->action = action;
   ret->previous = stateInfo_undefined;
+  ret->refs = 1;
+  ret->depth = 1;
 
   return ret;
 }
@@ -461,11 +556,31 @@ static /*@observer@*/ cstring stateAction_unparse (stateAction sa)
   BADBRANCH;
 }
 
-void stateInfo_display (stateInfo s, cstring sname)
+/*
+** Displays the history in *sp sorted in reverse location order.  The
+** sort rearranges the entries, so if any are shared *sp is replaced
+** by a copy first.
+*/
+
+void stateInfo_display (stateInfo *sp, cstring sname)
 {
   bool showdeep = context_flagOn (FLG_SHOWDEEPHISTORY, g_currentloc);
+  stateInfo s;
+
+  for (s = *sp; stateInfo_isDefined (s); s = s->previous)
+    {
+      if (s->refs > 1)
+	{
+	  stateInfo copy = stateInfo_prefix (*sp, (*sp)->depth);
+
+	  stateInfo_free (*sp);
+	  *sp = copy;
+	  break;
+	}
+    }
 
-  s = stateInfo_sort (s);
+  s = stateInfo_sort (*sp);
+  stateInfo_setDepths (*sp);
   
   while (stateInfo_isDefined (s))
     {
@@ -4025,13 +4025,13 @@ checkMetaStateConsistent (/*@exposed@*/ sRef fref, sRef tref,
     return;
   }
 
-  valueTable_elements (fvalues, fkey, fval) {
+  valueTable_elementsId (fvalues, fid, fval) {
     stateValue tval;
     metaStateInfo minfo;
 
-    DPRINTF (("Transfer: %s", fkey));
-    tval = valueTable_lookup (tvalues, fkey);
-    minfo = context_lookupMetaStateInfo (fkey);
+    tval = valueTable_lookupId (tvalues, fid);
+    minfo = context_getMetaStateInfo (fid);
+    DPRINTF (("Transfer: %s", metaStateInfo_getName (minfo)));
 
     if (!stateValue_isDefined (tval)) 
       {
@@ -4043,7 +4043,7 @@ checkMetaStateConsistent (/*@exposed@*/ sRef fref, sRef tref,
 	  {
 	    DPRINTF (("Cannot find meta state for: %s / to: %s / %s", sRef_unparseFull (fref),
 		      sRef_unparseFull (tref),
-		      fkey));
+		      metaStateInfo_getName (minfo)));
 	  }
       }
     else
@@ -4089,7 +4089,7 @@ checkMetaStateConsistent (/*@exposed@*/ sRef fref, sRef tref,
 			  ? message (": %s", msg) : cstring_undefined),
 			 loc))
 		      {
-			sRef_showMetaStateInfo (fref, fkey);
+			sRef_showMetaStateInfo (fref, metaStateInfo_getName (minfo));
 		      }		    
 		  }
 		else if (transferType == TT_GLOBPASS)
@@ -4106,7 +4106,7 @@ checkMetaStateConsistent (/*@exposed@*/ sRef fref, sRef tref,
 			  ? message (": %s", msg) : cstring_undefined),
 			 loc))
 		      {
-			sRef_showMetaStateInfo (fref, fkey);
+			sRef_showMetaStateInfo (fref, metaStateInfo_getName (minfo));
 		      }		    
 		  }
 		else if (transferType == TT_PARAMRETURN)
@@ -4123,7 +4123,7 @@ checkMetaStateConsistent (/*@exposed@*/ sRef fref, sRef tref,
 			  ? message (": %s", msg) : cstring_undefined),
 			 loc))
 		      {
-			sRef_showMetaStateInfo (fref, fkey);
+			sRef_showMetaStateInfo (fref, metaStateInfo_getName (minfo));
 		      }
 		  }
 		else
@@ -4140,7 +4140,7 @@ checkMetaStateConsistent (/*@exposed@*/ sRef fref, sRef tref,
 			  ? message (": %s", msg) : cstring_undefined),
 			 loc))
 		      {
-			sRef_showMetaStateInfo (fref, fkey);
+			sRef_showMetaStateInfo (fref, metaStateInfo_getName (minfo));
 		      }
 		  }
 
@@ -4154,8 +4154,8 @@ checkMetaStateConsistent (/*@exposed@*/ sRef fref, sRef tref,
       }
     
     DPRINTF (("Transfer: %s %s -> %s",
-	      fkey, stateValue_unparse (fval), stateValue_unparse (tval)));
-  } end_valueTable_elements ;
+	      metaStateInfo_getName (minfo), stateValue_unparse (fval), stateValue_unparse (tval)));
+  } end_valueTable_elementsId ;
 }
 
 static void
@@ -4180,16 +4180,16 @@ checkMetaStateTransfer (exprNode fexp, sRef fref, exprNode texp, sRef tref,
     return;
   }
 
-  valueTable_elements (fvalues, fkey, fval) {
+  valueTable_elementsId (fvalues, fid, fval) {
     stateValue tval;
     metaStateInfo minfo;
     stateCombinationTable sctable;
     cstring msg;
     int nval;
 
-    DPRINTF (("Transfer: %s", fkey));
-    tval = valueTable_lookup (tvalues, fkey);
-    minfo = context_lookupMetaStateInfo (fkey);
+    tval = valueTable_lookupId (tvalues, fid);
+    minfo = context_getMetaStateInfo (fid);
+    DPRINTF (("Transfer: %s", metaStateInfo_getName (minfo)));
 
     if (!stateValue_isDefined (tval)) 
       {
@@ -4203,7 +4203,7 @@ checkMetaStateTransfer (exprNode fexp, sRef fref, exprNode texp, sRef tref,
 		      exprNode_unparse (fexp), exprNode_unparse (texp)));
 	    DPRINTF (("Cannot find meta state for: %s / to: %s / %s", sRef_unparseFull (fref),
 		      sRef_unparseFull (tref),
-		      fkey));
+		      metaStateInfo_getName (minfo)));
 	  }
       }
     else
@@ -4234,7 +4234,7 @@ checkMetaStateTransfer (exprNode fexp, sRef fref, exprNode texp, sRef tref,
 	  }
 	else 
 	  {
-	    DPRINTF (("Check: %s / %s / %s / %s", fkey,
+	    DPRINTF (("Check: %s / %s / %s / %s", metaStateInfo_getName (minfo),
 		      metaStateInfo_unparse (minfo),
 		      stateValue_unparse (fval),
 		      stateValue_unparse (tval)));
@@ -4270,8 +4270,8 @@ checkMetaStateTransfer (exprNode fexp, sRef fref, exprNode texp, sRef tref,
 			  transferErrorExcerpt (transferType, fexp, texp, fcn)),
 			 loc))
 		      {
-			sRef_showMetaStateInfo (fref, fkey);
-			sRef_showMetaStateInfo (tref, fkey);
+			sRef_showMetaStateInfo (fref, metaStateInfo_getName (minfo));
+			sRef_showMetaStateInfo (tref, metaStateInfo_getName (minfo));
 		      }
 		    else
 		      {
@@ -4303,8 +4303,8 @@ checkMetaStateTransfer (exprNode fexp, sRef fref, exprNode texp, sRef tref,
       }
     
     DPRINTF (("Transfer: %s %s -> %s",
-	      fkey, stateValue_unparse (fval), stateValue_unparse (tval)));
-  } end_valueTable_elements ;
+	      metaStateInfo_getName (minfo), stateValue_unparse (fval), stateValue_unparse (tval)));
+  } end_valueTable_elementsId ;
 }
 
 /*
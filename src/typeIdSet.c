@@ -38,6 +38,58 @@ static /*@only@*/ o_usymIdSet *tistable;
 static void tistable_addDirectEntry (/*@only@*/ usymIdSet p_s) 
    /*@modifies tistable, tistableentries, tistablefree@*/;
 
+/*
+** tisindex is an open-addressing hash index on the tistable entries
+** (keyed by usymIdSet_hash), so interning a set does not need to scan
+** the whole table.  It is kept at most half full; empty slots are -1.
+*/
+
+/*@constant int TISINDEXBASESIZE;@*/
+# define TISINDEXBASESIZE 256
+
+static /*@only@*/ /*@null@*/ int *tisindex = NULL;
+static int tisindexsize = 0;
+
+static void tistable_rehash (void)
+   /*@modifies tisindex, tisindexsize@*/ ;
+
+/*
+** typeIdSet_union and typeIdSet_subtract results are memoized in
+** small direct-mapped caches.  Since sets are interned and never change,
+** entries stay valid until the table is destroyed.
+*/
+
+/*@constant int TISCACHESIZE;@*/
+# define TISCACHESIZE 1024
+
+typedef struct
+{
+  typeIdSet t1;
+  typeIdSet t2;
+  typeIdSet result;
+} tisCacheEntry;
+
+static tisCacheEntry tisUnionCache[TISCACHESIZE];
+static tisCacheEntry tisSubtractCache[TISCACHESIZE];
+
+static void tistable_clearCaches (void)
+   /*@modifies tisUnionCache, tisSubtractCache@*/
+{
+  int i;
+
+  for (i = 0; i < TISCACHESIZE; i++)
+    {
+      tisUnionCache[i].t1 = -1;
+      tisSubtractCache[i].t1 = -1;
+    }
+}
+
+static int tistable_cacheIndex (typeIdSet t1, typeIdSet t2) /*@*/
+{
+  unsigned int h = ((unsigned int) t1 * 31U) ^ (unsigned int) t2;
+  return (int) (h % TISCACHESIZE);
+}
+
 void typeIdSet_initMod (void)
    /*@globals undef tistable;@*/
    /*@modifies tistable, tistablefree;@*/
@@ -49,6 +101,9 @@ void typeIdSet_initMod (void)
   tistable[0] = usymIdSet_undefined;
   tistableentries = 1;
   tistablefree--;
+
+  tistable_rehash ();
+  tistable_clearCaches ();
 }
 
 void typeIdSet_destroyMod (void)
@@ -63,6 +118,10 @@ void typeIdSet_destroyMod (void)
 
   sfree (tistable);
   tistableentries = 0;
+
+  sfree (tisindex);
+  tisindex = NULL;
+  tisindexsize = 0;
 }
 
 void typeIdSet_dumpTable (FILE *fout)
@@ -124,11 +183,16 @@ void typeIdSet_loadTable (FILE *fin)
 static void tistable_grow (void)
 {
   o_usymIdSet *oldtable = tistable;
-  int newsize = tistableentries + TISTABLEBASESIZE;
+  int newsize = tistableentries * 2;
   int i;
 
   llassert (tistablefree == 0);
 
+  if (newsize < TISTABLEBASESIZE)
+    {
+      newsize = TISTABLEBASESIZE;
+    }
+
   tistable = (usymIdSet *) dmalloc (sizeof (tistable) * newsize);
 
   for (i = 0; i < tistableentries; i++)
@@ -136,10 +200,51 @@ static void tistable_grow (void)
       tistable[i] = oldtable[i];
     }
 
-  tistablefree = TISTABLEBASESIZE;
+  tistablefree = newsize - tistableentries;
   sfree (oldtable);
 } 
 
+static void tistable_indexInsert (int index)
+   /*@modifies tisindex@*/
+{
+  unsigned int mask = (unsigned int) tisindexsize - 1;
+  unsigned int slot = usymIdSet_hash (tistable[index]) & mask;
+
+  llassert (tisindex != NULL);
+
+  while (tisindex[slot] != -1)
+    {
+      slot = (slot + 1) & mask;
+    }
+
+  tisindex[slot] = index;
+}
+
+static void tistable_rehash (void)
+{
+  int newsize = (tisindexsize == 0) ? TISINDEXBASESIZE : tisindexsize;
+  int i;
+
+  while (newsize < 2 * (tistableentries + 1))
+    {
+      newsize *= 2;
+    }
+
+  sfree (tisindex);
+  tisindex = (int *) dmalloc (sizeof (*tisindex) * newsize);
+  tisindexsize = newsize;
+
+  for (i = 0; i < newsize; i++)
+    {
+      tisindex[i] = -1;
+    }
+
+  for (i = 0; i < tistableentries; i++)
+    {
+      tistable_indexInsert (i);
+    }
+}
+
 static void tistable_addDirectEntry (/*@only@*/ usymIdSet s)
 {
   if (tistablefree == 0)
@@ -150,15 +255,35 @@ static void tistable_addDirectEntry (/*@only@*/ usymIdSet s)
   tistable[tistableentries] = s;
   tistableentries++;
   tistablefree--;
+
+  if (2 * tistableentries > tisindexsize)
+    {
+      tistable_rehash ();
+    }
+  else
+    {
+      tistable_indexInsert (tistableentries - 1);
+    }
 }
 
 static int tistable_addEntry (/*@only@*/ usymIdSet s)
 {
-  int i;
+  unsigned int mask;
+  unsigned int slot;
 
-  
-  for (i = 0; i < tistableentries; i++)
+  if (tisindex == NULL)
     {
+      tistable_rehash ();
+    }
+
+  llassert (tisindex != NULL);
+  mask = (unsigned int) tisindexsize - 1;
+  slot = usymIdSet_hash (s) & mask;
+
+  while (tisindex[slot] != -1)
+    {
+      int i = tisindex[slot];
+
       if (usymIdSet_compare (tistable[i], s) == 0)
 	{
 	  /*@access usymIdSet@*/
@@ -166,8 +291,10 @@ static int tistable_addEntry (/*@only@*/ usymIdSet s)
 	  /*@noaccess usymIdSet@*/
 
 	  usymIdSet_free (s);
-	  	  return i;
+	  return i;
 	}
+
+      slot = (slot + 1) & mask;
     }
 
   tistable_addDirectEntry (s);
@@ -261,8 +388,18 @@ typeIdSet typeIdSet_subtract (typeIdSet s, typeIdSet t)
     }
   else
     {
-      return (tistable_addEntry (usymIdSet_subtract (tistable_fetch (s),
-						     tistable_fetch (t))));
+      int ci = tistable_cacheIndex (s, t);
+
+      if (tisSubtractCache[ci].t1 != s || tisSubtractCache[ci].t2 != t)
+	{
+	  tisSubtractCache[ci].result 
+	    = tistable_addEntry (usymIdSet_subtract (tistable_fetch (s),
+						     tistable_fetch (t)));
+	  tisSubtractCache[ci].t1 = s;
+	  tisSubtractCache[ci].t2 = t;
+	}
+
+      return tisSubtractCache[ci].result;
     }
 }
 
@@ -294,7 +431,17 @@ typeIdSet typeIdSet_union (typeIdSet t1, typeIdSet t2)
     }
   else
     {
-      return (tistable_addEntry (usymIdSet_newUnion (tistable_fetch (t1),
-						     tistable_fetch (t2))));
+      int ci = tistable_cacheIndex (t1, t2);
+
+      if (tisUnionCache[ci].t1 != t1 || tisUnionCache[ci].t2 != t2)
+	{
+	  tisUnionCache[ci].result 
+	    = tistable_addEntry (usymIdSet_newUnion (tistable_fetch (t1),
+						     tistable_fetch (t2)));
+	  tisUnionCache[ci].t1 = t1;
+	  tisUnionCache[ci].t2 = t2;
+	}
+
+      return tisUnionCache[ci].result;
     }
 }
@@ -976,6 +976,7 @@ uentry_makeFunctionAux (cstring n, ctype t,
   e->used = FALSE;
   e->lset = FALSE;
   e->uses = filelocList_new ();
+  e->useid = useId_invalid;
   e->isPrivate = priv;
   e->hasNameError = FALSE;
 
@@ -2363,6 +2364,7 @@ uentry_reflectOtherQualifier (/*@notnull@*/ uentry ue, qual qel)
       else
 	{
 	  ue->info->datatype->abs = qel;
+	  ctype_invalidateRealTypes ();
 	  DPRINTF (("Setting abstract %s: %s",
 		    uentry_unparse (ue), qual_unparse (qel)));
 	}
@@ -3171,6 +3173,7 @@ uentry uentry_makeConstantAux (cstring n, ctype t,
   e->used = FALSE;
   
   e->uses = filelocList_new ();
+  e->useid = useId_invalid;
   e->isPrivate = priv;
   e->hasNameError = FALSE;
 
@@ -3332,6 +3335,7 @@ uentry uentry_makeVariableAux (cstring n, ctype t,
   e->lset = FALSE;
 
   e->uses = filelocList_new ();
+  e->useid = useId_invalid;
   e->isPrivate = priv;
   e->hasNameError = FALSE;
 
@@ -3813,6 +3817,7 @@ uentry_makeUnspecFunction (cstring n, ctype t,
 
   e->warn = warnClause_undefined; 
   e->uses = filelocList_new ();
+  e->useid = useId_invalid;
   e->isPrivate = priv;
   e->hasNameError = FALSE;
 
@@ -3877,6 +3882,7 @@ static /*@only@*/ /*@notnull@*/ uentry
 
   e->warn = warnClause_undefined; 
   e->uses = filelocList_new ();
+  e->useid = useId_invalid;
   e->isPrivate = FALSE;
   e->hasNameError = FALSE;
 
@@ -3913,6 +3919,7 @@ uentry_makeEndIterAux (cstring n, typeIdSet access, /*@only@*/ fileloc f)
   e->lset = FALSE;
 
   e->uses = filelocList_new ();
+  e->useid = useId_invalid;
   e->isPrivate = FALSE;
   e->hasNameError = FALSE;
 
@@ -3960,6 +3967,7 @@ static /*@only@*/ /*@notnull@*/ uentry
   e->lset = FALSE;
 
   e->uses = filelocList_new ();
+  e->useid = useId_invalid;
   e->isPrivate = priv;
   e->hasNameError = FALSE;
 
@@ -4098,6 +4106,7 @@ uentry_makeElipsisMarker (void)
 
       uentry_setSpecDef (emarker, fileloc_undefined);
       emarker->uses = filelocList_new ();
+      emarker->useid = useId_invalid;
       emarker->isPrivate = FALSE;
       emarker->hasNameError = FALSE;
     }
@@ -4147,8 +4156,8 @@ uentry_xcompareuses (uentry *p1, uentry *p2)
     {
       if (uentry_isValid (u2))
 	{
-	  return (-1 * int_compare (filelocList_size (u1->uses), 
-				    filelocList_size (u2->uses)));
+	  return (-1 * int_compare (useIndex_count (u1->useid), 
+				    useIndex_count (u2->useid)));
 	}
       else
 	{
@@ -4316,6 +4325,7 @@ static uentry
 
   e->whereDefined = fileloc_undefined;
   e->uses = filelocList_new ();
+  e->useid = useId_invalid;
   e->isPrivate = FALSE;
   e->hasNameError = FALSE;
 
@@ -4370,6 +4380,7 @@ static /*@only@*/ uentry
   e->lset = FALSE;
 
   e->uses = filelocList_new ();
+  e->useid = useId_invalid;
   e->warn = warnClause_undefined; 
 
   e->info = (uinfo) dmalloc (sizeof (*e->info));
@@ -4459,6 +4470,7 @@ uentry_makeDatatypeBase (/*@only@*/ cstring name, ctype ct, qual abstract,
   e->used = FALSE;
   e->lset = FALSE;
   e->uses = filelocList_new ();
+  e->useid = useId_invalid;
 
   e->info = (uinfo) dmalloc (sizeof (*e->info));
   e->info->datatype = (udinfo) dmalloc (sizeof (*e->info->datatype));
@@ -4591,6 +4603,7 @@ static uentry
   e->used = FALSE;
   e->lset = FALSE;
   e->uses = filelocList_new ();  
+  e->useid = useId_invalid;
   e->warn = warnclause;
 
   e->info = (uinfo) dmalloc (sizeof (*e->info));
@@ -4661,6 +4674,7 @@ static /*@only@*/ uentry
   e->used = FALSE;
   e->lset = FALSE;
   e->uses = filelocList_new ();
+  e->useid = useId_invalid;
   e->warn = warnClause_undefined; 
 
   e->info = (uinfo) dmalloc (sizeof (*e->info));
@@ -4706,6 +4720,7 @@ static uentry
   e->used = FALSE;
   e->lset = FALSE;
   e->uses = filelocList_new ();
+  e->useid = useId_invalid;
   e->warn = warnClause_undefined; 
 
   e->info = (uinfo) dmalloc (sizeof (*e->info));
@@ -4750,6 +4765,7 @@ static uentry
   e->used = FALSE;
   e->lset = FALSE;
   e->uses = filelocList_new ();
+  e->useid = useId_invalid;
   e->warn = warnClause_undefined; 
 
   e->info = (uinfo) dmalloc (sizeof (*e->info));
@@ -5505,6 +5521,7 @@ uentry_setAbstract (uentry e)
   oldid = ctype_typeId (e->info->datatype->type);
   e->info->datatype->abs = qual_createAbstract ();
   e->info->datatype->type = ctype_createAbstract (oldid);
+  ctype_invalidateRealTypes ();
 }
 
 void
@@ -5515,6 +5532,7 @@ uentry_setConcrete (uentry e)
 		|| qual_isConcrete (e->info->datatype->abs)));
 
   e->info->datatype->abs = qual_createConcrete ();
+  ctype_invalidateRealTypes ();
 }
 
 bool
@@ -6310,6 +6328,11 @@ uentry_setType (uentry e, ctype t)
     {
       e->utype = t;
       sRef_setType (e->sref, t);
+
+      if (uentry_isDatatype (e))
+	{
+	  ctype_invalidateRealTypes ();
+	}
     }
 }
 
@@ -6597,6 +6620,7 @@ uentry uentry_nameCopy (cstring name, uentry e)
   enew->hasNameError = FALSE;
 
   enew->uses = filelocList_new ();
+  enew->useid = useId_invalid;
   enew->warn = warnClause_undefined; 
 
   enew->storageclass = e->storageclass;
@@ -6626,6 +6650,8 @@ uentry_setDatatype (uentry e, typeId uid)
     {
       e->info->datatype->type = ctype_createUser (uid);
     }
+
+  ctype_invalidateRealTypes ();
 }
 
 static void 
@@ -7347,6 +7373,7 @@ checkStructConformance (uentry old, uentry unew)
 	}
 
       old->utype = unew->utype;
+      ctype_invalidateRealTypes ();
     }
 }
 
@@ -7376,6 +7403,7 @@ checkEnumConformance (/*@notnull@*/ uentry old, /*@notnull@*/ uentry unew)
 	{
 	  uentry_showWhereSpecified (old);
 	  old->utype = unew->utype;
+	  ctype_invalidateRealTypes ();
 	}
     }
 }
@@ -7960,9 +7988,9 @@ checkMetaState (/*@notnull@*/ uentry old, /*@notnull@*/ uentry unew,
       ** Copy the new values into the old ref
       */
 
-      valueTable_elements (newvals, key, newval)
+      valueTable_elements (newvals, id, key, newval)
 	{
-	  metaStateInfo msinfo = context_lookupMetaStateInfo (key);
+	  metaStateInfo msinfo = context_getMetaStateInfo (id);
 	  stateValue oldval = sRef_getMetaStateValue (old->sref, key);
             
 	  llassert (metaStateInfo_isDefined (msinfo));
@@ -8912,6 +8940,7 @@ uentry_checkDatatypeConformance (/*@notnull@*/ uentry old,
       if (ctype_isUnknown (old->info->datatype->type))
 	{
 	  old->info->datatype->type = unew->info->datatype->type;
+	  ctype_invalidateRealTypes ();
 	}
       else
 	{
@@ -8943,6 +8972,7 @@ uentry_checkDatatypeConformance (/*@notnull@*/ uentry old,
 		}
 
 	      old->info->datatype->type = unew->info->datatype->type;
+	      ctype_invalidateRealTypes ();
 	    }
 	}
     }
@@ -9363,6 +9393,11 @@ uentry_checkConformance (/*@unique@*/ /*@notnull@*/ uentry old,
 		  else
 		    {
 		      old->utype = unew->utype;
+
+		      if (uentry_isDatatype (old))
+			{
+			  ctype_invalidateRealTypes ();
+			}
 		    }
 		}
 	    }
@@ -9372,6 +9407,11 @@ uentry_checkConformance (/*@unique@*/ /*@notnull@*/ uentry old,
 	  if (ctype_isUnknown (old->utype))
 	    {
 	      old->utype = unew->utype;
+
+	      if (uentry_isDatatype (old))
+		{
+		  ctype_invalidateRealTypes ();
+		}
 	    }
 	}
     }  
@@ -9801,6 +9841,8 @@ uentry_mergeDefinition (uentry old, /*@only@*/ uentry unew)
   old->used = old->used || unew->used;
   old->uses = filelocList_append (old->uses, unew->uses);
   unew->uses = filelocList_undefined; 
+  old->useid = useIndex_merge (old->useid, unew->useid);
+  unew->useid = useId_invalid;
 
   sRef_storeState (old->sref); 
   sRef_storeState (unew->sref);
@@ -10005,6 +10047,8 @@ static void uentry_updateInto (/*@unique@*/ uentry unew, uentry old)
   unew->hasNameError = old->hasNameError;
   unew->uses = filelocList_append (unew->uses, old->uses);
   old->uses = filelocList_undefined;
+  unew->useid = useIndex_merge (unew->useid, old->useid);
+  old->useid = useId_invalid;
 
   unew->storageclass = old->storageclass;
   uinfo_free (unew->info, okind);
@@ -10041,6 +10085,7 @@ uentry_copyAux (uentry e, bool saveCopy)
       enew->isPrivate = e->isPrivate;
       enew->hasNameError = e->hasNameError;
       enew->uses = filelocList_undefined;
+      enew->useid = useId_invalid;
       
       enew->storageclass = e->storageclass;
       enew->info = uinfo_copy (e->info, e->ukind);
@@ -10084,6 +10129,8 @@ uentry_setState (uentry res, uentry other)
   filelocList_free (res->uses); 
   res->uses = other->uses; 
   other->uses = filelocList_undefined; 
+  res->useid = other->useid;
+  other->useid = useId_invalid;
   res->lset = other->lset;
 }
 
@@ -10097,6 +10144,8 @@ uentry_mergeUses (uentry res, uentry other)
   res->lset = other->lset || res->lset;
   res->uses = filelocList_append (res->uses, other->uses);
   other->uses = filelocList_undefined;
+  res->useid = useIndex_merge (res->useid, other->useid);
+  other->useid = useId_invalid;
 }
 
 
@@ -10455,19 +10504,19 @@ uentry_mergeValueStates (/*@notnull@*/ uentry res, /*@notnull@*/ uentry other,
     }
   else
     {
-      valueTable_elements (ovalues, fkey, fval) {
+      valueTable_elements (ovalues, fid, fkey, fval) {
 	stateValue tval;
 	metaStateInfo minfo;
 	stateCombinationTable sctable;
 	cstring msg;
 	int nval;
 
-	tval = valueTable_lookup (rvalues, fkey);
+	tval = valueTable_lookupId (rvalues, fid);
 	
 	DPRINTF (("Merge value: %s / %s X %s", fkey, 
 		  stateValue_unparse (fval), stateValue_unparse (tval)));
 
-	minfo = context_lookupMetaStateInfo (fkey);
+	minfo = context_getMetaStateInfo (fid);
 	llassert (stateValue_isDefined (tval));
 	
 	if (metaStateInfo_isUndefined (minfo) || !stateValue_isDefined (tval)) 
@@ -10608,6 +10657,8 @@ uentry_mergeSetStates (/*@notnull@*/ uentry res,
       res->lset = other->lset || res->lset;
       res->uses = filelocList_append (res->uses, other->uses);
       other->uses = filelocList_undefined;
+      res->useid = useIndex_merge (res->useid, other->useid);
+      other->useid = useId_invalid;
     }
   else
     {
@@ -10658,6 +10709,8 @@ uentry_mergeSetStates (/*@notnull@*/ uentry res,
 	  res->lset = other->lset || res->lset;
 	  res->uses = filelocList_append (res->uses, other->uses);
 	  other->uses = filelocList_undefined;
+	  res->useid = useIndex_merge (res->useid, other->useid);
+	  other->useid = useId_invalid;
 	}
     }
 }
@@ -10772,7 +10825,7 @@ void uentry_setUsed (uentry e, fileloc loc)
 	{
 	  if (showUses)
 	    {
-	      e->uses = filelocList_add (e->uses, fileloc_copy (loc));
+	      e->useid = useIndex_add (e->useid, loc);
 	    }
 	  else 
 	    {
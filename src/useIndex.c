@@ -0,0 +1,287 @@
+/*
+** Splint - annotation-assisted static program checker
+** Copyright (C) 1994-2003 University of Virginia,
+**         Massachusetts Institute of Technology
+**
+** This program is free software; you can redistribute it and/or modify it
+** under the terms of the GNU General Public License as published by the
+** Free Software Foundation; either version 2 of the License, or (at your
+** option) any later version.
+**
+** This program is distributed in the hope that it will be useful, but
+** WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** General Public License for more details.
+**
+** The GNU General Public License is available from http://www.gnu.org/ or
+** the Free Software Foundation, Inc., 59 Temple Place - Suite 330, Boston,
+** MA 02111-1307, USA.
+**
+** For information on splint: info@splint.org
+** To report a bug: splint-bug@splint.org
+** For more information: http://www.splint.org
+*/
+/*
+** useIndex.c
+**
+** Each use is written to the uses file as a fixed size record.  Only
+** the id table is kept in memory: s_parent links merged ids (union-find)
+** and s_count holds the number of uses of each representative id.
+*/
+
+# include "splintMacros.nf"
+# include "basic.h"
+
+typedef struct
+{
+  int id;
+  int kind;
+  int fid;
+  int lineno;
+  int column;
+} useRecord;
+
+static /*@null@*/ FILE *s_usesFile = NULL;
+static int s_nids = 0;
+static int s_idspace = 0;
+static /*@null@*/ /*@only@*/ int *s_parent = NULL;
+static /*@null@*/ /*@only@*/ int *s_count = NULL;
+
+static useId useIndex_find (useId id)
+   /*@globals s_parent@*/ /*@modifies s_parent@*/
+{
+  llassert (s_parent != NULL);
+  llassert (id >= 0 && id < s_nids);
+
+  while (s_parent[id] != id)
+    {
+      s_parent[id] = s_parent[s_parent[id]];
+      id = s_parent[id];
+    }
+
+  return id;
+}
+
+static useId useIndex_newId (void)
+{
+  if (s_nids >= s_idspace)
+    {
+      int newspace = (s_idspace == 0) ? MIDBASESIZE : 2 * s_idspace;
+      int *newparent = (int *) dmalloc (sizeof (*newparent) * newspace);
+      int *newcount = (int *) dmalloc (sizeof (*newcount) * newspace);
+      int i;
+
+      for (i = 0; i < s_nids; i++)
+	{
+	  llassert (s_parent != NULL && s_count != NULL);
+	  newparent[i] = s_parent[i];
+	  newcount[i] = s_count[i];
+	}
+
+      sfree (s_parent);
+      sfree (s_count);
+      s_parent = newparent;
+      s_count = newcount;
+      s_idspace = newspace;
+    }
+
+  llassert (s_parent != NULL && s_count != NULL);
+  s_parent[s_nids] = s_nids;
+  s_count[s_nids] = 0;
+  s_nids++;
+
+  return s_nids - 1;
+}
+
+/*
+** Records a use at loc (which may be undefined) for id (a new id if
+** id is invalid), and returns the id.
+*/
+
+useId useIndex_add (useId id, fileloc loc)
+{
+  useRecord r;
+
+  if (!useId_isValid (id))
+    {
+      id = useIndex_newId ();
+    }
+
+  llassert (s_count != NULL);
+  s_count[useIndex_find (id)]++;
+
+  if (s_usesFile == NULL)
+    {
+      s_usesFile = tmpfile ();
+      
+      if (s_usesFile == NULL)
+	{
+	  llfatalerror (cstring_makeLiteral
+			("Cannot create temporary file for recording uses"));
+	}
+    }
+
+  r.id = id;
+
+  if (fileloc_isDefined (loc))
+    {
+      r.kind = (int) loc->kind;
+      r.fid = loc->fid;
+      r.lineno = loc->lineno;
+      r.column = loc->column;
+    }
+  else
+    {
+      r.kind = NOT_FOUND;
+      r.fid = fileId_invalid;
+      r.lineno = 0;
+      r.column = 0;
+    }
+
+  if (fwrite (&r, sizeof (r), 1, s_usesFile) != 1)
+    {
+      llfatalerror (cstring_makeLiteral ("Error writing uses file"));
+    }
+
+  return id;
+}
+
+/*
+** Merges the uses of other into id.  The uses of either are the
+** uses of the result.
+*/
+
+useId useIndex_merge (useId id, useId other)
+{
+  if (!useId_isValid (other))
+    {
+      return id;
+    }
+  else if (!useId_isValid (id))
+    {
+      return other;
+    }
+  else
+    {
+      useId root = useIndex_find (id);
+      useId oroot = useIndex_find (other);
+
+      if (root != oroot)
+	{
+	  llassert (s_parent != NULL && s_count != NULL);
+	  s_parent[oroot] = root;
+	  s_count[root] += s_count[oroot];
+	}
+
+      return id;
+    }
+}
+
+int useIndex_count (useId id)
+{
+  if (!useId_isValid (id))
+    {
+      return 0;
+    }
+
+  llassert (s_count != NULL);
+  return s_count[useIndex_find (id)];
+}
+
+/*
+** Returns the uses of ids[0..n-1] (in the order they were recorded).
+** The file is read once, so callers should ask for many ids at a time.
+*/
+
+/*@only@*/ filelocList *useIndex_read (useId *ids, int n)
+{
+  filelocList *res = (filelocList *) dmalloc (sizeof (*res) * size_fromInt (n > 0 ? n : 1));
+  int *slots;
+  useRecord r;
+  int i;
+
+  for (i = 0; i < n; i++)
+    {
+      res[i] = filelocList_new ();
+    }
+
+  if (s_usesFile == NULL || n == 0)
+    {
+      return res;
+    }
+
+  slots = (int *) dmalloc (sizeof (*slots) * size_fromInt (s_nids));
+
+  for (i = 0; i < s_nids; i++)
+    {
+      slots[i] = NOT_FOUND;
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      if (useId_isValid (ids[i]))
+	{
+	  slots[useIndex_find (ids[i])] = i;
+	}
+    }
+
+  if (fflush (s_usesFile) != 0 || fseek (s_usesFile, 0L, SEEK_SET) != 0)
+    {
+      llfatalerror (cstring_makeLiteral ("Error reading uses file"));
+    }
+
+  while (fread (&r, sizeof (r), 1, s_usesFile) == 1)
+    {
+      int slot = slots[useIndex_find (r.id)];
+
+      if (slot != NOT_FOUND)
+	{
+	  struct s_fileloc fl;
+
+	  fl.kind = (flkind) r.kind;
+	  fl.fid = r.fid;
+	  fl.lineno = r.lineno;
+	  fl.column = r.column;
+
+	  if (r.kind == NOT_FOUND)
+	    {
+	      res[slot] = filelocList_add (res[slot], fileloc_undefined);
+	    }
+	  else if (fileloc_isBuiltin (&fl))
+	    {
+	      res[slot] = filelocList_add (res[slot],
+					   fileloc_copy (fileloc_observeBuiltin ()));
+	    }
+	  else if (fileloc_isExternal (&fl))
+	    {
+	      res[slot] = filelocList_add (res[slot],
+					   fileloc_copy (fileloc_getExternal ()));
+	    }
+	  else
+	    {
+	      res[slot] = filelocList_add (res[slot], fileloc_copy (&fl));
+	    }
+	}
+    }
+
+  /* later writes must follow a positioning call */
+  (void) fseek (s_usesFile, 0L, SEEK_END);
+  sfree (slots);
+  return res;
+}
+
+void useIndex_destroyMod (void)
+{
+  if (s_usesFile != NULL)
+    {
+      (void) fclose (s_usesFile);
+      s_usesFile = NULL;
+    }
+
+  sfree (s_parent);
+  sfree (s_count);
+  s_parent = NULL;
+  s_count = NULL;
+  s_nids = 0;
+  s_idspace = 0;
+}
@@ -386,3 +386,22 @@ usymIdSet_compare (usymIdSet l1, usymIdSet l2)
     return (int_compare (li1, li2));
   }
 }
+
+/*
+** Hash consistent with usymIdSet_compare: sets that compare equal
+** (same elements in the same order, with undefined equal to empty)
+** hash the same.
+*/
+
+unsigned int
+usymIdSet_hash (usymIdSet s)
+{
+  unsigned int h = 0;
+
+  usymIdSet_elements (s, el)
+    {
+      h = (h * 31) + (unsigned int) usymId_toInt (el);
+    } end_usymIdSet_elements;
+
+  return h;
+}
@@ -102,7 +102,11 @@ static /*@checkedstrict@*/ /*@owned@*/ usymtab oldtab;
 
 static int usymtab_lexicalLevel (void) /*@globals utab@*/ ;
 static bool usymtab_isAltDefinitelyNull (sRef p_s) /*@globals utab@*/ ;
-static void refTable_free (/*@only@*/ /*@null@*/ refTable p_x, int p_nentries);
+static /*@only@*/ refTable refTable_create (int p_size) /*@*/ ;
+static void refTable_free (/*@only@*/ /*@null@*/ refTable p_x);
+static void refTable_grow (refTable p_x, int p_nentries, int p_size) /*@modifies p_x@*/ ;
+static void refTable_add (refTable p_x, int p_i, int p_level, int p_index) 
+   /*@modifies p_x@*/ ;
 static ctype usymtab_suFieldsType (uentryList p_f, bool p_isStruct) /*@globals globtab@*/ ;
 
 static void usymtab_freeAux (/*@only@*/ usymtab p_u)
@@ -291,9 +295,7 @@ static /*@notnull@*/ /*@special@*/ usymtab
   /* We only use a reftable for branch-level symbol tables. 
   */
 
-  t->reftable = (nextlevel 
-		 ? NULL
-		 : (refentry *) dmalloc (sizeof (*t->reftable) * CBASESIZE));
+  t->reftable = (nextlevel ? NULL : refTable_create (CBASESIZE));
   
   t->kind = kind;
   t->lexlevel = (env == GLOBAL_ENV ? 0 : env->lexlevel) + (nextlevel ? 1 : 0); 
@@ -419,7 +421,12 @@ usymtab_grow (/*@notnull@*/ usymtab s)
   int i;
   o_uentry *oldsyms = s->entries;
 
-  s->nspace = CBASESIZE;
+  /*
+  ** Grow in proportion to the table, so loading a large library
+  ** into the global table is not quadratic.
+  */
+
+  s->nspace = s->nentries > CBASESIZE ? s->nentries : CBASESIZE;
   s->entries = (uentry *) dmalloc (sizeof (*s->entries) 
 				   * (s->nentries + s->nspace));
 
@@ -432,19 +439,7 @@ usymtab_grow (/*@notnull@*/ usymtab s)
 
   if (s->reftable != NULL)
     {
-      refTable oldRefs = s->reftable;
-
-      s->reftable = (refentry *) dmalloc (sizeof (*s->reftable)
-					  * (s->nentries + CBASESIZE + 1));
-      
-      for (i = 0; i < s->nentries; i++)
-	{
-	  s->reftable[i] = oldRefs[i];
-	}
-
-      /*@-compdestroy@*/ 
-      sfree (oldRefs);
-      /*@=compdestroy@*/ 
+      refTable_grow (s->reftable, s->nentries, s->nentries + s->nspace + 1);
     }
       
 }
@@ -1063,6 +1058,11 @@ usymtab_replaceEntryAux (/*@notnull@*/ usymtab st, /*@only@*/ uentry e)
 				   cstring_copy (uentry_rawName (e)));
 	}
 
+      if (uentry_isDatatype (ce))
+	{
+	  ctype_invalidateRealTypes ();
+	}
+
       uentry_free (ce);
       st->entries[eindex] = e;
     }
@@ -1654,7 +1654,7 @@ static void
 usymtab_shallowFree (/*@only@*/ /*@notnull@*/ usymtab s)
 {
   aliasTable_free (s->aliases);
-  refTable_free (s->reftable, s->nentries);
+  refTable_free (s->reftable);
   sfree (s->entries);
   /*@-compdestroy@*/ sfree (s); /*@=compdestroy@*/
 }
@@ -1897,6 +1897,7 @@ void usymtab_load (FILE *f)
   uentry ue;
 
   dbgload = TRUE;
+  ctype_invalidateRealTypes ();
 
   llassert (utab == globtab);
   llassert (utab->nentries == 0);
@@ -2094,6 +2095,13 @@ void usymtab_load (FILE *f)
     }
     
   dbgload = FALSE;
+
+  /*
+  ** Type entries are looked up differently once dbgload is off, so
+  ** real types memoized during the load (as unknown) are stale.
+  */
+
+  ctype_invalidateRealTypes ();
   sfree (os);
 }
 
@@ -3411,58 +3419,111 @@ void usymtab_exportHeader (void)
     }
 }
 
+/*
+** With showalluses, the uses are kept in the useIndex.  Returns the
+** uses of entries first to *last - 1 of s: as many entries as have
+** USEINDEX_READLIMIT uses (but at least one).
+*/
+
+static /*@only@*/ filelocList *
+usymtab_readUses (/*@notnull@*/ usymtab s, int first, /*@out@*/ int *last)
+{
+  useId *ids = (useId *) dmalloc (sizeof (*ids) * size_fromInt (s->nentries - first + 1));
+  filelocList *res;
+  int total = 0;
+  int i = first;
+
+  while (i < s->nentries && (i == first || total < USEINDEX_READLIMIT))
+    {
+      ids[i - first] = uentry_getUseId (s->entries[i]);
+      total += useIndex_count (ids[i - first]);
+      i++;
+    }
+
+  res = useIndex_read (ids, i - first);
+  sfree (ids);
+  *last = i;
+  return res;
+}
+
+static void usymtab_checkExportLocal (uentry ce, filelocList fuses)
+{
+  if (!uentry_isDatatype (ce) && !uentry_isAnyTag (ce) 
+      && !uentry_isEitherConstant (ce) 
+      && !uentry_isIter (ce)
+      && !uentry_isEndIter (ce)
+      && !uentry_isExpandedMacro (ce)
+      && uentry_isUsed (ce))
+    {
+      /* check static uses */
+      fileloc mod = uentry_whereDefined (ce);
+      bool ok = filelocList_isEmpty (fuses);
+      fileloc fwhere = uentry_whereDeclared (ce);
+      
+      if (fileloc_isSpecialFile (fwhere)
+	  && !context_getFlag (FLG_UNUSEDSPECIAL))
+	{
+	  ok = TRUE; /* no errors for special files */
+	}
+      else
+	{
+	  filelocList_elements (fuses, uloc)
+	    {
+	      if (fileloc_isUndefined (uloc) || !fileloc_sameModule (uloc, mod))
+		{
+		  ok = TRUE;
+		  /*@innerbreak@*/ break;
+		}
+	    } end_filelocList_elements;
+	}
+      
+      if (!ok)
+	{
+	  if (optgenerror
+	      (FLG_EXPORTLOCAL,
+	       message ("%s exported but not used outside %s: %q", 
+			ekind_capName (uentry_getKind (ce)),
+			fileloc_getBase (mod),
+			uentry_getName (ce)),
+	       fwhere))
+	    {
+	      uentry_showDefSpecInfo (ce, fwhere);
+	    }
+	}
+    }
+}
+
 void usymtab_exportLocal (void)
    /*@globals utab@*/
 {
   int i;
   
-  for (i = 0; i < utab->nentries; i++)
+  if (context_getFlag (FLG_SHOWUSES))
     {
-      uentry ce = utab->entries[i];
-      
-      if (!uentry_isDatatype (ce) && !uentry_isAnyTag (ce) 
-	  && !uentry_isEitherConstant (ce) 
-	  && !uentry_isIter (ce)
-	  && !uentry_isEndIter (ce)
-	  && !uentry_isExpandedMacro (ce)
-	  && uentry_isUsed (ce))
-	{
-	  /* check static uses */
-	  filelocList fuses = uentry_getUses (ce);
-	  fileloc mod = uentry_whereDefined (ce);
-	  bool ok = filelocList_isEmpty (fuses);
-	  fileloc fwhere = uentry_whereDeclared (ce);
+      int first = 0;
 
-	  if (fileloc_isSpecialFile (fwhere)
-	      && !context_getFlag (FLG_UNUSEDSPECIAL))
-	    {
-	      ok = TRUE; /* no errors for special files */
-	    }
-	  else
-	    {
-	      filelocList_elements (fuses, uloc)
-		{
-		  if (fileloc_isUndefined (uloc) || !fileloc_sameModule (uloc, mod))
-		    {
-		      ok = TRUE;
-		      /*@innerbreak@*/ break;
-		    }
-		} end_filelocList_elements;
-	    }
+      while (first < utab->nentries)
+	{
+	  int last;
+	  filelocList *uses = usymtab_readUses (utab, first, &last);
 
-	  if (!ok)
+	  for (i = first; i < last; i++)
 	    {
-	      if (optgenerror
-		  (FLG_EXPORTLOCAL,
-		   message ("%s exported but not used outside %s: %q", 
-			    ekind_capName (uentry_getKind (ce)),
-			    fileloc_getBase (mod),
-			    uentry_getName (ce)),
-		   fwhere))
-		{
-		  uentry_showDefSpecInfo (ce, fwhere);
-		}
+	      usymtab_checkExportLocal (utab->entries[i], uses[i - first]);
+	      filelocList_free (uses[i - first]);
 	    }
+
+	  sfree (uses);
+	  first = last;
+	}
+    }
+  else
+    {
+      for (i = 0; i < utab->nentries; i++)
+	{
+	  uentry ce = utab->entries[i];
+
+	  usymtab_checkExportLocal (ce, uentry_getUses (ce));
 	}
     }
 }
@@ -3912,12 +3973,12 @@ void usymtab_checkFinalScope (bool isReturn)
 	      
 	      tvalues = sRef_getValueTable (sr);
 	      
-	      valueTable_elements (tvalues, fkey, fval) {
+	      valueTable_elementsId (tvalues, fid, fval) {
 		metaStateInfo minfo;
 		cstring msg = cstring_undefined;
 		int nval;
 		
-		minfo = context_lookupMetaStateInfo (fkey);
+		minfo = context_getMetaStateInfo (fid);
 		llassert (metaStateInfo_isDefined (minfo));
 		
 		if (stateValue_isError (fval)
@@ -3927,12 +3988,10 @@ void usymtab_checkFinalScope (bool isReturn)
 		  }
 		else 
 		  {
-		    DPRINTF (("Check: %s / %s / %s", fkey,
+		    DPRINTF (("Check: %s / %s / %s", metaStateInfo_getName (minfo),
 			      metaStateInfo_unparse (minfo),
 			      stateValue_unparse (fval)));
 		    
-		    minfo = context_lookupMetaStateInfo (fkey);
-		    
 		    nval = stateCombinationTable_lookupLoseReference 
 		      (metaStateInfo_getTransferTable (minfo), 
 		       stateValue_getValue (fval), &msg);
@@ -3957,7 +4016,7 @@ void usymtab_checkFinalScope (bool isReturn)
 			  }
 		      }
 		  }
-	      } end_valueTable_elements;
+	      } end_valueTable_elementsId;
 	    }
 
 	  DPRINTF (("Check mustfree entry: %s", uentry_unparseFull (ce)));
@@ -4853,34 +4912,111 @@ usymtab_getRefNoisy (/*@notnull@*/ usymtab s, int level, usymId index)
 ** the branch table.
 */
 
+static unsigned int refTable_hash (/*@notnull@*/ refTable rt, int level, int index)
+{
+  return (((unsigned int) level * 31u) + (unsigned int) index) 
+    & (unsigned int) (rt->hashsize - 1);
+}
+
 static
 int refTable_lookup (/*@notnull@*/ usymtab ut, int level, usymId index)
 {
   refTable rt = ut->reftable;
-  int i;
+  unsigned int h;
 
   llassert (rt != NULL);
 
-  for (i = 0; i < ut->nentries; i++)
+  h = refTable_hash (rt, level, usymId_toInt (index));
+
+  while (rt->hashed[h] != NOT_FOUND)
     {
-      if (rt[i]->level == level && rt[i]->index == usymId_toInt (index))
+      refentry *ref = &rt->elements[rt->hashed[h]];
+
+      if (ref->level == level && ref->index == usymId_toInt (index))
 	{
-	  return i;
+	  return rt->hashed[h];
 	}
+
+      h = (h + 1) & (unsigned int) (rt->hashsize - 1);
     }
   
   return NOT_FOUND;
 }
-  
-static
-/*@only@*/ refentry refentry_create (int level, int index)
+
+static /*@only@*/ refTable refTable_create (int size)
+{
+  refTable rt = (refTable) dmalloc (sizeof (*rt));
+  int i;
+
+  rt->elements = (refentry *) dmalloc (sizeof (*rt->elements) * size);
+  rt->hashsize = REFTABLEHASHBASESIZE;
+  rt->hashed = (int *) dmalloc (sizeof (*rt->hashed) * rt->hashsize);
+
+  for (i = 0; i < rt->hashsize; i++)
+    {
+      rt->hashed[i] = NOT_FOUND;
+    }
+
+  return rt;
+}
+
+static void refTable_grow (refTable rt, int nentries, int size)
 {
-  refentry r = (refentry) dmalloc (sizeof (*r));
+  refentry *oldelements = rt->elements;
+  int i;
 
-  r->level = level;
-  r->index = index;
+  rt->elements = (refentry *) dmalloc (sizeof (*rt->elements) * size);
 
-  return r;
+  for (i = 0; i < nentries; i++)
+    {
+      rt->elements[i] = oldelements[i];
+    }
+
+  sfree (oldelements);
+}
+
+static void refTable_insertHash (/*@notnull@*/ refTable rt, int i)
+{
+  unsigned int h = refTable_hash (rt, rt->elements[i].level, rt->elements[i].index);
+
+  while (rt->hashed[h] != NOT_FOUND)
+    {
+      h = (h + 1) & (unsigned int) (rt->hashsize - 1);
+    }
+
+  rt->hashed[h] = i;
+}
+
+/*
+** Sets element i (the newest entry) and adds it to the hash, which
+** is doubled when more than half full.
+*/
+
+static void refTable_add (refTable rt, int i, int level, int index)
+{
+  rt->elements[i].level = level;
+  rt->elements[i].index = index;
+
+  if ((i + 1) * 2 > rt->hashsize)
+    {
+      int j;
+
+      sfree (rt->hashed);
+      rt->hashsize *= 2;
+      rt->hashed = (int *) dmalloc (sizeof (*rt->hashed) * rt->hashsize);
+
+      for (j = 0; j < rt->hashsize; j++)
+	{
+	  rt->hashed[j] = NOT_FOUND;
+	}
+
+      for (j = 0; j < i; j++)
+	{
+	  refTable_insertHash (rt, j);
+	}
+    }
+
+  refTable_insertHash (rt, i);
 }
 
 static /*@dependent@*/ /*@exposed@*/ uentry
@@ -4924,15 +5060,15 @@ usymtab_addRefEntry (/*@notnull@*/ usymtab s, cstring k)
 	      
 	      if (s->reftable != NULL)
 		{
-		  refentry ref = s->reftable[eindex];
+		  refentry ref = s->reftable->elements[eindex];
 		  
-		  ut->reftable[ut->nentries - 1] 
-		    = refentry_create (ref->level, ref->index);
+		  refTable_add (ut->reftable, ut->nentries - 1,
+				ref.level, ref.index);
 		}
 	      else
 		{
-		  ut->reftable[ut->nentries - 1] 
-		    = refentry_create (s->lexlevel, usymId_toInt (eindex));
+		  refTable_add (ut->reftable, ut->nentries - 1,
+				s->lexlevel, usymId_toInt (eindex));
 		}
 	      
 	      return (ue);
@@ -5358,17 +5494,12 @@ bool usymtab_existsVar (cstring k)
 */
 
 static void
-refTable_free (/*@only@*/ /*@null@*/ refTable x, int nentries)
+refTable_free (/*@only@*/ /*@null@*/ refTable x)
 {
   if (x != NULL)
     {
-      int i;
-
-      for (i = 0; i < nentries; i++)
-	{
-	  sfree (x[i]);
-	}
-      
+      sfree (x->elements);
+      sfree (x->hashed);
       sfree (x);
     }
 }
@@ -5382,7 +5513,7 @@ usymtab_freeLevel (/*@notnull@*/ /*@only@*/ usymtab u)
   DPRINTF (("Free level [%p]", u));
   aliasTable_free (u->aliases);
 
-  refTable_free (u->reftable, u->nentries);
+  refTable_free (u->reftable);
 
   if (u == filetab || u == globtab)
     {
@@ -5643,6 +5774,7 @@ usymtab_displayAllUses ()
   /*@globals utab, globtab@*/
 {
   usymtab copy;
+  int first = 0;
 
   /* only in top scope */
   llassert (utab == globtab);
@@ -5653,24 +5785,38 @@ usymtab_displayAllUses ()
   qsort (copy->entries, (size_t)copy->nentries, 
 	 sizeof (*copy->entries), (int (*)(const void *, const void *)) uentry_xcompareuses);
 
-  usymtab_entries (copy, ue)
+  while (first < copy->nentries)
     {
-      if (uentry_isValid (ue) && !uentry_isGlobalMarker (ue))
+      int last;
+      filelocList *uses = usymtab_readUses (copy, first, &last);
+      int i;
+
+      for (i = first; i < last; i++)
 	{
-	  filelocList uses = uentry_getUses (ue);
-	  int size = filelocList_realSize (uses);
+	  uentry ue = copy->entries[i];
+	  filelocList ulist = uses[i - first];
 
-	  if (fileloc_isDefined (uentry_whereDefined (ue)) 
-	      && !fileloc_isLib (uentry_whereDefined (ue))
-	      && (size > 0))
+	  if (uentry_isValid (ue) && !uentry_isGlobalMarker (ue))
 	    {
-	      llmsg (message ("%q (%q), %d use%&:\n   %q", 
-			      uentry_getName (ue),
-			      fileloc_unparse (uentry_whereDefined (ue)),
-			      size, filelocList_unparseUses (uses)));
+	      int size = filelocList_realSize (ulist);
+	      
+	      if (fileloc_isDefined (uentry_whereDefined (ue)) 
+		  && !fileloc_isLib (uentry_whereDefined (ue))
+		  && (size > 0))
+		{
+		  llmsg (message ("%q (%q), %d use%&:\n   %q", 
+				  uentry_getName (ue),
+				  fileloc_unparse (uentry_whereDefined (ue)),
+				  size, filelocList_unparseUses (ulist)));
+		}
 	    }
+
+	  filelocList_free (ulist);
 	}
-    } end_usymtab_entries;
+
+      sfree (uses);
+      first = last;
+    }
   
   usymtab_shallowFree (copy);
 }
@@ -5873,8 +6019,8 @@ usymtab_printOut (void)
 	  for (i = 0; i < s->nentries; i++)
 	    {
 	      fprintf (g_warningstream, "\t%s %3d: %d, %d\n", ind, i, 
-		       s->reftable[i]->level,
-		       s->reftable[i]->index);
+		       s->reftable->elements[i].level,
+		       s->reftable->elements[i].index);
 	    }
 	}
 
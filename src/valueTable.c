@@ -23,31 +23,175 @@
 */
 /*
 ** valueTable.c
-** Based on genericTable.c
+**
+** The values are kept in an array indexed by metastate id, so
+** transfers and merges need no name lookups.
 */
 
 # include "splintMacros.nf"
 # include "basic.h"
-# include "randomNumbers.h"
 
-valueTable valueTable_copy (valueTable s)
+valueTable valueTable_create (int size)
 {
-  if (valueTable_size (s) > 0)
+  valueTable h = (valueTable) dmalloc (sizeof (*h));
+  int i;
+
+  if (size < 1)
+    {
+      size = 1;
+    }
+
+  h->size = size;
+  h->values = (stateValue *) dmalloc (sizeof (*h->values) * size);
+
+  for (i = 0; i < size; i++)
     {
-      valueTable t;
-      t = valueTable_create (valueTable_size (s));
-      
-      valueTable_elements (s, key, val) 
+      h->values[i] = stateValue_undefined;
+    }
+
+  return h;
+}
+
+static void valueTable_grow (/*@notnull@*/ valueTable h, int id)
+   /*@modifies h@*/
+{
+  int newsize = context_numMetaStates ();
+  stateValue *newvalues;
+  int i;
+
+  if (newsize <= id)
+    {
+      newsize = id + 1;
+    }
+
+  newvalues = (stateValue *) dmalloc (sizeof (*newvalues) * newsize);
+
+  for (i = 0; i < newsize; i++)
+    {
+      if (i < h->size)
 	{
-	  valueTable_insert (t, cstring_copy (key), stateValue_copy (val));
-	} end_valueTable_elements ;
-	
-	llassert (valueTable_size (s) == valueTable_size (t));
-	return t;
+	  llassert (h->values != NULL);
+	  newvalues[i] = h->values[i];
+	}
+      else
+	{
+	  newvalues[i] = stateValue_undefined;
+	}
+    }
+
+  sfree (h->values);
+  h->values = newvalues;
+  h->size = newsize;
+}
+
+void valueTable_insertId (valueTable h, int id, stateValue value)
+{
+  llassert (stateValue_isDefined (value));
+  llassert (id >= 0);
+
+  if (id >= h->size)
+    {
+      valueTable_grow (h, id);
+    }
+
+  llassert (h->values != NULL);
+  llassert (stateValue_isUndefined (h->values[id]));
+  h->values[id] = value;
+}
+
+void valueTable_updateId (valueTable h, int id, stateValue newval)
+{
+  DPRINTF (("Update: %d -> %s", id, stateValue_unparse (newval)));
+  llassert (stateValue_isDefined (newval));
+
+  if (id < 0 || id >= h->size || stateValue_isUndefined (h->values[id]))
+    {
+      llbug (message ("valueTable_update: %d not found", id));
+    }
+
+  /* can't free the old value, it may be exposed */
+  h->values[id] = newval;
+}
+
+static int valueTable_keyId (cstring key) /*@*/
+{
+  metaStateInfo msinfo = context_lookupMetaStateInfo (key);
+
+  if (metaStateInfo_isDefined (msinfo))
+    {
+      return metaStateInfo_getId (msinfo);
     }
   else
     {
-      return valueTable_undefined;
+      return -1;
+    }
+}
+
+void valueTable_insert (valueTable h, cstring key, stateValue value)
+{
+  int id = valueTable_keyId (key);
+
+  llassert (id >= 0);
+  cstring_free (key);
+  valueTable_insertId (h, id, value);
+}
+
+void valueTable_update (valueTable h, cstring key, stateValue newval) 
+{
+  valueTable_updateId (h, valueTable_keyId (key), newval);
+}
+
+stateValue valueTable_lookup (valueTable h, cstring key)
+{
+  if (valueTable_isDefined (h))
+    {
+      int id = valueTable_keyId (key);
+
+      if (id >= 0)
+	{
+	  return valueTable_lookupId (h, id);
+	}
+    }
+
+  return stateValue_undefined;
+}
+
+/*
+** The copy of a table with no values is undefined.
+*/
+
+valueTable valueTable_copy (valueTable s)
+{
+  valueTable t = valueTable_undefined;
+
+  valueTable_elementsId (s, id, val) 
+    {
+      if (valueTable_isUndefined (t))
+	{
+	  t = valueTable_create (s->size);
+	}
+
+      llassert (t->values != NULL);
+      t->values[id] = stateValue_copy (val);
+    } end_valueTable_elementsId ;
+	
+  return t;
+}
+
+void valueTable_free (valueTable h)
+{
+  if (valueTable_isDefined (h))
+    {
+      int i;
+
+      for (i = 0; i < h->size; i++)
+	{
+	  /* can't free val contents */
+	  sfree (h->values[i]);
+	}
+
+      sfree (h->values);
+      sfree (h);
     }
 }
 
@@ -55,25 +199,12 @@ cstring valueTable_unparse (valueTable h)
 {
   cstring res = cstring_newEmpty ();
 
-  valueTable_elements (h, key, val) {
+  valueTable_elements (h, id, key, val) {
     DPRINTF (("Using key: %s", key));
     res = message ("%q%s: %q [%q]; ", res, key, 
-		   stateValue_unparseValue (val, context_lookupMetaStateInfo (key)),
+		   stateValue_unparseValue (val, context_getMetaStateInfo (id)),
 		   stateValue_unparse (val));
   } end_valueTable_elements ;
   
   return res;
 }
-
-void valueTable_insert (valueTable h, cstring key, stateValue value)
-{
-  llassert (stateValue_isDefined (value));
-  genericTable_insert ((genericTable) (h), key, (void *) (value));
-}
-
-void valueTable_update (valueTable h, cstring key, stateValue newval) 
-{
-  DPRINTF (("Update: %s -> %s", key, stateValue_unparse (newval)));
-  llassert (stateValue_isDefined (newval));
-  genericTable_update ((genericTable) (h), key, (void *) (newval));
-}
@@ -0,0 +1,10 @@
+/*
+** Checked by both jobs in batch.jobs; the second uses +charint.
+*/
+
+int f (void)
+{
+  int x = "one"; /* 1, 1. Variable x initialized to type char *, expects int */
+  char c = 3.5;  /* 2, 2. Variable c initialized to type double, expects char */
+  return x + c;  /* 3. Incompatible types for + (int, char) */
+}
@@ -0,0 +1,141 @@
+#! /bin/sh
+##
+## genbench.sh - generate synthetic C inputs for the Splint benchmark
+##
+## Usage: genbench.sh class scale
+##
+## Writes a C file exercising one kind of input to standard output.  The
+## size of the input grows linearly with scale.  Classes:
+##
+##   nesting   functions with deeply nested control flow
+##   longfcn   long functions
+##   macros    many function-like macros, each used many times
+##   globals   many global variables and functions that use them
+##   bounds    buffer manipulation for checking with +bounds
+##
+
+if test $# -ne 2; then
+  echo "Usage: $0 class scale" >&2
+  exit 1
+fi
+
+class=$1
+scale=$2
+
+case $class in
+  nesting|longfcn|macros|globals|bounds) ;;
+  *) echo "$0: unknown class: $class" >&2; exit 1 ;;
+esac
+
+awk -v class="$class" -v scale="$scale" '
+function nesting (  f, d, ind)
+{
+  for (f = 0; f < 40 * scale; f++)
+    {
+      printf "int nest%d (int a, int b)\n{\n  int r = 0;\n", f;
+      ind = "  ";
+      for (d = 0; d < 12; d++)
+	{
+	  if (d % 3 == 0)
+	    printf "%sif (a > %d)\n%s{\n", ind, d, ind;
+	  else if (d % 3 == 1)
+	    printf "%swhile (b > %d)\n%s{\n%s  b--;\n", ind, d, ind, ind;
+	  else
+	    printf "%sswitch (a %% %d)\n%s{\n%scase 0:\n", ind, d + 2, ind, ind;
+	  ind = ind "  ";
+	  printf "%sr += a * %d;\n", ind, d;
+	}
+      for (d = 11; d >= 0; d--)
+	{
+	  ind = substr (ind, 3);
+	  if (d % 3 == 2)
+	    printf "%s  break;\n%sdefault:\n%s  r--;\n", ind, ind, ind;
+	  printf "%s}\n", ind;
+	}
+      printf "  return r;\n}\n\n";
+    }
+}
+
+function longfcn (  f, i)
+{
+  printf "extern int ext (int);\n\n";
+  for (f = 0; f < 2 * scale; f++)
+    {
+      printf "int longfcn%d (int a)\n{\n  int x = a;\n  int y = 0;\n", f;
+      for (i = 0; i < 300; i++)
+	{
+	  if (i % 4 == 0)
+	    printf "  x = x + %d;\n", i;
+	  else if (i % 4 == 1)
+	    printf "  y = ext (x) - y;\n";
+	  else if (i % 4 == 2)
+	    printf "  if (x > y) { x = y; } else { y = x + %d; }\n", i;
+	  else
+	    printf "  x = (x * 3) %% (y + %d);\n", i + 1;
+	}
+      printf "  return x + y;\n}\n\n";
+    }
+}
+
+function macros (  m, f, i)
+{
+  for (m = 0; m < 100 * scale; m++)
+    {
+      printf "# define MAC%d(x, y) ((x) > (y) ? (x) + %d : (y) - %d)\n", m, m, m;
+    }
+  printf "\n";
+  for (f = 0; f < 10 * scale; f++)
+    {
+      printf "int usemacros%d (int a, int b)\n{\n  int r = 0;\n", f;
+      for (i = 0; i < 50; i++)
+	{
+	  printf "  r += MAC%d (a, b) + MAC%d (r, %d);\n", 
+	    (f * 50 + i) % (100 * scale), (f + i) % (100 * scale), i;
+	}
+      printf "  return r;\n}\n\n";
+    }
+}
+
+function globals (  g, f, i)
+{
+  for (g = 0; g < 500 * scale; g++)
+    {
+      printf "int glob%d = %d;\n", g, g;
+    }
+  printf "\n";
+  for (f = 0; f < 100 * scale; f++)
+    {
+      printf "int useglobs%d (void)\n{\n", f;
+      for (i = 0; i < 5; i++)
+	{
+	  printf "  glob%d += glob%d;\n", 
+	    (f * 5 + i) % (500 * scale), (f * 7 + i) % (500 * scale);
+	}
+      printf "  return glob%d;\n}\n\n", f % (500 * scale);
+    }
+}
+
+function bounds (  f)
+{
+  printf "# include <string.h>\n\n";
+  for (f = 0; f < 30 * scale; f++)
+    {
+      printf "void buf%d (char *s, int n)\n{\n", f;
+      printf "  char b[%d];\n  int i;\n", 16 + f % 32;
+      printf "  strcpy (b, s);\n";
+      printf "  for (i = 0; i < n; i++)\n    {\n      b[i] = s[i];\n    }\n";
+      printf "  b[%d] = %s;\n", 15 + f % 32, "\047\\0\047";
+      printf "  (void) strncpy (b, s, (size_t) n);\n";
+      printf "  memcpy (b, s, sizeof (b));\n}\n\n";
+    }
+}
+
+BEGIN {
+  printf "/* Generated by genbench.sh %s %d */\n\n", class, scale;
+
+  if (class == "nesting") nesting();
+  else if (class == "longfcn") longfcn();
+  else if (class == "macros") macros();
+  else if (class == "globals") globals();
+  else bounds();
+}'
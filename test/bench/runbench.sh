@@ -0,0 +1,69 @@
+#! /bin/sh
+##
+## runbench.sh - run the Splint benchmark
+##
+## Usage: runbench.sh splint scale [class ...]
+##
+## Generates an input for each class with genbench.sh, checks it with
+## +stats and reports the lines checked per second.  Peak memory is
+## reported if GNU time is available (set TIME to its path if it is not
+## /usr/bin/time).
+##
+
+if test $# -lt 2; then
+  echo "Usage: $0 splint scale [class ...]" >&2
+  exit 1
+fi
+
+splint=$1
+scale=$2
+shift 2
+
+if test $# -eq 0; then
+  set nesting longfcn macros globals bounds
+fi
+
+bindir=`dirname $0`
+TIME=${TIME-/usr/bin/time}
+
+if $TIME -f %M true >/dev/null 2>&1; then
+  havetime=yes
+else
+  havetime=no
+fi
+
+printf "%-10s %10s %10s %12s %10s\n" class lines seconds lines/sec "peak KB"
+
+for class in "$@"; do
+  input=bench-$class.c
+  flags="-nof -hints +stats"
+
+  if test $class = bounds; then
+    flags="$flags +bounds"
+  fi
+
+  sh $bindir/genbench.sh $class $scale >$input || exit 1
+
+  if test $havetime = yes; then
+    $TIME -f "peak %M" -o bench-$class.time \
+      $splint $flags $input >bench-$class.out 2>&1
+    peak=`awk '/^peak/ { print $2 }' bench-$class.time`
+  else
+    $splint $flags $input >bench-$class.out 2>&1
+    peak=-
+  fi
+
+  awk -v class=$class -v peak="$peak" '
+    / source lines in .* s\.$/ { lines = $1; secs = $(NF - 1) }
+    END {
+      if (lines == "")
+        {
+          printf "%-10s   *** no statistics (see bench-%s.out) ***\n", class, class;
+          exit 1;
+        }
+      printf "%-10s %10d %10.2f %12.0f %10s\n", class, lines, secs,
+        (secs > 0 ? lines / secs : 0), peak;
+    }' bench-$class.out || status=1
+done
+
+exit ${status-0}
@@ -0,0 +1,14 @@
+/*
+** Included by both compactfiles1.c and compactfiles2.c.  Messages in
+** the header are reported once, and its macros are checked once.
+*/
+
+# define ISZERO(x) ((x) == 0) /* 1. Parameterized macro has no prototype */
+# define SQUARE(x) ((x) * (x)) /* 2, 3. No prototype, parameter x used more than once */
+
+extern int shared;
+
+static int unused (void) { return 3; } /* 4. File static function unused declared but not used */
+
+extern int cf1 (int p_x);
+extern int cf2 (int p_x);
@@ -0,0 +1,9 @@
+# include "compactfiles.h"
+# include "compactfiles1.h"
+
+int cf1 (int x)
+{
+  int s = x;
+  (void) s; /* 5. Statement has no effect */
+  return SQUARE (x) + (ISZERO (x) ? shared : 1);
+}
@@ -0,0 +1,6 @@
+/*
+** Macros here are checked along with compactfiles1.c, so +compactfiles
+** frees their definitions once that file is checked.
+*/
+
+# define TWICE(x) ((x) + (x)) /* 7, 8. No prototype, parameter x used more than once */
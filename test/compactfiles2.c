@@ -0,0 +1,14 @@
+# include "compactfiles.h"
+# include "compactfiles1.h"
+
+int cf2 (int x)
+{
+  int y;
+
+  if (ISZERO (x))
+    {
+      return y; /* 6. Variable y used before definition */
+    }
+
+  return SQUARE (x) + cf1 (TWICE (x));
+}
@@ -0,0 +1,11 @@
+/*
+** +json writes one JSON object per warning.  The first string is Latin-1
+** (not valid UTF-8), the second is UTF-8.
+*/
+
+int f (void)
+{
+  int x = "caf"; /* 1. Variable x initialized to type char *, expects int */
+  int y = "café"; /* 2. Variable y initialized to type char *, expects int */
+  return x + y;
+}
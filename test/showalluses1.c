@@ -0,0 +1,47 @@
+/*
+** +showalluses lists each global with its uses.  Uses in branches of
+** if and switch statements are merged when the branches join.
+*/
+
+int counter;
+int limit = 10;
+int localonly; /* exportlocal: used only in this file */
+
+int scale (int x) /* exportlocal: used only in this file */
+{
+  return x * localonly;
+}
+
+static void bump (void) { counter++; }
+
+int tick (int x)
+{
+  if (x > limit)
+    {
+      counter = 0;
+      bump ();
+    }
+  else if (x < 0)
+    {
+      counter--;
+    }
+  else
+    {
+      bump ();
+    }
+
+  switch (x)
+    {
+    case 1:
+      return counter;
+    case 2:
+      return limit;
+    default:
+      localonly = x;
+      break;
+    }
+
+  return scale (x);
+}
+
+int unusedfcn (void) { return 3; }
@@ -0,0 +1,13 @@
+/*
+** Uses of globals from showalluses1.c.
+*/
+
+extern int counter;
+extern int limit;
+extern int tick (int x);
+
+int main (void)
+{
+  counter = tick (limit);
+  return tick (counter) + tick (2);
+}